@@ -157,6 +157,8 @@ namespace api {
 
 
     context::~context() {
+        if (!m_params.owns_manager() && m_params.m_bulk_release && !m_params.m_debug_ref_count)
+            m().set_bulk_release();
         if (m_parser)
             smt2::free_parser(m_parser);
         m_last_obj = nullptr;
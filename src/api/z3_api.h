@@ -1544,6 +1544,7 @@ extern "C" {
 
             - proof  (Boolean)           Enable proof generation
             - debug_ref_count (Boolean)  Enable debug support for Z3_ast reference counting
+            - bulk_release (Boolean)     Release all terms at once when the context is deleted
             - trace  (Boolean)           Tracing support for VCC
             - trace_file_name (String)   Trace out file for VCC traces
             - timeout (unsigned)         default timeout (in milliseconds) used for solvers
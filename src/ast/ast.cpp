@@ -1371,6 +1371,8 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
+    set_concurrent(false);
+    dealloc(m_lock);
 
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
@@ -1386,6 +1388,26 @@ ast_manager::~ast_manager() {
             dealloc(p);
     }
     m_plugins.reset();
+    if (m_bulk_release) {
+        // nodes in the chunks of m_alloc are released with it. Only the declaration
+        // info of sorts and function declarations, and the nodes that m_alloc
+        // obtained from memory::allocate, are freed here.
+        for (ast * n : m_ast_table) {
+            decl_info * info = nullptr;
+            if (is_sort(n))
+                info = to_sort(n)->get_info();
+            else if (is_func_decl(n))
+                info = to_func_decl(n)->get_info();
+            if (info) {
+                info->del_eh(*this);
+                dealloc(info);
+            }
+            unsigned sz = ::get_node_size(n);
+            if (!small_object_allocator::is_chunked(sz))
+                deallocate_node(n, sz);
+        }
+        m_ast_table.reset();
+    }
     while (!m_ast_table.empty()) {
         DEBUG_CODE(IF_VERBOSE(1, verbose_stream() << "ast_manager LEAKED: " << m_ast_table.size() << std::endl););
         ptr_vector<ast> roots;
@@ -1685,7 +1707,36 @@ static void track_id(ast_manager& m, ast* n, unsigned id) {
 }
 #endif
 
+void ast_manager::set_concurrent(bool f) {
+    if (f == m_concurrent)
+        return;
+    if (f) {
+        if (!m_lock)
+            m_lock = alloc(recursive_mutex);
+        m_concurrent = true;
+        return;
+    }
+    m_concurrent = false;
+    // delete nodes that are still unreferenced.
+    // delete_node removes nodes from m_deferred before they are deallocated.
+    while (!m_deferred.empty()) {
+        ast * n = *m_deferred.begin();
+        m_deferred.erase(n);
+        if (n->get_ref_count() == 0)
+            delete_node(n);
+    }
+}
+
+void ast_manager::dec_ref_concurrent(ast * n) {
+    if (n->dec_ref_atomic() == 0) {
+        concurrent_lock lock(*this);
+        m_deferred.insert(n);
+    }
+}
+
 ast * ast_manager::register_node_core(ast * n) {
+    SASSERT(!m_read_only);
+    concurrent_lock lock(*this);
     unsigned h = get_node_hash(n);
     n->m_hash = h;
 #ifdef Z3DEBUG
@@ -1804,12 +1855,16 @@ ast * ast_manager::register_node_core(ast * n) {
 
 
 void ast_manager::delete_node(ast * n) {
+    if (m_bulk_release)
+        return;
     TRACE(delete_node_bug, tout << mk_ll_pp(n, *this) << "\n";);
 
     SASSERT(m_ast_table.contains(n));
     m_ast_table.push_erase(n);
 
     while ((n = m_ast_table.pop_erase())) {
+        if (!m_deferred.empty())
+            m_deferred.erase(n);
 
         CTRACE(del_quantifier, is_quantifier(n), tout << "deleting quantifier " << n->m_id << " " << n << "\n";);
         TRACE(mk_var_bug, tout << "del_ast: " << " " << n->m_ref_count << "\n";);
@@ -1880,6 +1935,7 @@ void ast_manager::delete_node(ast * n) {
 
 
 sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters) {
+    concurrent_lock lock(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_sort(k, num_parameters, parameters);
@@ -1888,6 +1944,7 @@ sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters,
 
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned arity, sort * const * domain, sort * range) {
+    concurrent_lock lock(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, arity, domain, range);
@@ -1896,6 +1953,7 @@ func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_p
 
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned num_args, expr * const * args, sort * range) {
+    concurrent_lock lock(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, num_args, args, range);
@@ -2271,6 +2329,7 @@ app * ast_manager::mk_app(func_decl * decl, unsigned num_args, expr * const * ar
 
 func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const & suffix, unsigned arity,
                                             sort * const * domain, sort * range, bool skolem) {
+    concurrent_lock lock(*this);
     func_decl_info info(null_family_id, null_decl_kind);
     info.m_skolem = skolem;
     SASSERT(skolem == info.is_skolem());
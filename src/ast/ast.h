@@ -47,6 +47,8 @@ Revision History:
 #include "util/z3_exception.h"
 #include "util/dependency.h"
 #include "util/rlimit.h"
+#include "util/mutex.h"
+#include <atomic>
 #include <variant>
 
 #define RECYCLE_FREE_AST_INDICES
@@ -497,6 +499,15 @@ protected:
         --m_ref_count;
     }
 
+    void inc_ref_atomic() {
+        std::atomic_ref<unsigned>(m_ref_count).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    unsigned dec_ref_atomic() {
+        SASSERT(m_ref_count > 0);
+        return std::atomic_ref<unsigned>(m_ref_count).fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
     ast(ast_kind k): m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false) {
         DEBUG_CODE({
             m_mark1_owner = 0;
@@ -1524,6 +1535,11 @@ protected:
     std::fstream*             m_trace_stream = nullptr;
     bool                      m_trace_stream_owner = false;
     bool                      m_has_type_vars = false;
+    bool                      m_read_only = false;
+    bool                      m_concurrent = false;
+    bool                      m_bulk_release = false;
+    recursive_mutex *         m_lock = nullptr;
+    obj_hashtable<ast>        m_deferred;       // nodes whose reference count dropped to zero in concurrent mode
 #ifdef Z3DEBUG
     bool slow_not_contains(ast const * n);
 #endif
@@ -1653,16 +1669,51 @@ public:
 
     void debug_ref_count() { m_debug_ref_count = true; }
 
+    /**
+       \brief a read-only manager may be shared by several threads that translate terms from it.
+       No terms are created in a read-only manager and translations do not update reference
+       counts of its terms. The terms being translated must be kept alive by their owner.
+    */
+    void set_read_only(bool f) { m_read_only = f; }
+    bool is_read_only() const { return m_read_only; }
+
+    /**
+       \brief in concurrent mode several threads may create terms and update reference counts
+       in the manager. Creation of terms and access to decl plugins through the manager are
+       serialized by a lock, reference counts are updated atomically, and terms whose reference
+       count drops to zero are only deleted when concurrent mode is disabled again.
+       Concurrent mode must be enabled and disabled while no other thread uses the manager.
+    */
+    void set_concurrent(bool f);
+    bool is_concurrent() const { return m_concurrent; }
+
+    /**
+       \brief in bulk release mode terms are no longer deleted when their reference count drops
+       to zero. They stay in the manager, and the memory of all terms is released at once when
+       the manager is destroyed. Use it before tearing down the objects that own a manager
+       that is about to be deleted, instead of freeing terms one by one.
+    */
+    void set_bulk_release() { m_bulk_release = true; }
+    bool is_bulk_release() const { return m_bulk_release; }
+
     void inc_ref(ast* n) {
-        if (n) 
-            n->inc_ref();
+        if (n) {
+            if (m_concurrent)
+                n->inc_ref_atomic();
+            else
+                n->inc_ref();
+        }
     }
     
     void dec_ref(ast* n) {
         if (n) {
-            n->dec_ref();
-            if (n->get_ref_count() == 0)
-                delete_node(n);
+            if (m_concurrent) 
+                dec_ref_concurrent(n);
+            else {
+                n->dec_ref();
+                if (n->get_ref_count() == 0)
+                    delete_node(n);
+            }
         }
     }
 
@@ -1698,11 +1749,22 @@ protected:
 
     void delete_node(ast * n);
 
+    void dec_ref_concurrent(ast * n);
+
+    class concurrent_lock {
+        recursive_mutex * m_lock;
+    public:
+        concurrent_lock(ast_manager const & m): m_lock(m.m_concurrent ? m.m_lock : nullptr) { if (m_lock) m_lock->lock(); }
+        ~concurrent_lock() { if (m_lock) m_lock->unlock(); }
+    };
+
     void * allocate_node(unsigned size) {
+        concurrent_lock lock(*this);
         return m_alloc.allocate(size);
     }
 
     void deallocate_node(ast * n, unsigned sz) {
+        concurrent_lock lock(*this);
         m_alloc.deallocate(sz, n);
     }
 
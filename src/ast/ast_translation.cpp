@@ -24,6 +24,7 @@ Revision History:
 #include "ast/ast_translation.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_pp.h"
+#include "util/mutex.h"
 
 ast_translation::~ast_translation() {
     reset_cache();
@@ -39,7 +40,8 @@ void ast_translation::cleanup() {
 
 void ast_translation::reset_cache() {
     for (auto & kv : m_cache) {
-        m_from_manager.dec_ref(kv.m_key);
+        if (!m_from_read_only)
+            m_from_manager.dec_ref(kv.m_key);
         m_to_manager.dec_ref(kv.m_value);
     }
     m_cache.reset();
@@ -48,7 +50,8 @@ void ast_translation::reset_cache() {
 void ast_translation::cache(ast * s, ast * t) {
     SASSERT(!m_cache.contains(s));
     if (s->get_ref_count() > 1) {
-        m_from_manager.inc_ref(s);
+        if (!m_from_read_only)
+            m_from_manager.inc_ref(s);
         m_to_manager.inc_ref(t);
         m_cache.insert(s, t);
         ++m_insert_count;
@@ -358,11 +361,19 @@ ast * ast_translation::process(ast const * _n) {
     return r;
 }
 
+// linearize marks dependencies of the source manager.
+static DECLARE_INIT_MUTEX(s_read_only_lock);
+
 expr_dependency * expr_dependency_translation::operator()(expr_dependency * d) {
     if (d == nullptr)
         return d;
     m_buffer.reset();
-    m_translation.from().linearize(d, m_buffer);
+    if (m_translation.from().is_read_only()) {
+        lock_guard lock(*s_read_only_lock);
+        m_translation.from().linearize(d, m_buffer);
+    }
+    else
+        m_translation.from().linearize(d, m_buffer);
     unsigned sz = m_buffer.size();
     SASSERT(sz >= 1);
     for (unsigned i = 0; i < sz; i++) {
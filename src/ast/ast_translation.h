@@ -32,6 +32,7 @@ class ast_translation {
     };
     ast_manager &       m_from_manager;
     ast_manager &       m_to_manager;
+    bool                m_from_read_only;
     svector<frame>      m_frame_stack;
     ptr_vector<ast>     m_extra_children_stack; // for sort and func_decl, since they have nested AST in their parameters
     ptr_vector<ast>     m_result_stack; 
@@ -53,7 +54,7 @@ class ast_translation {
     ast * process(ast const * n);
 
 public:
-    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true) : m_from_manager(from), m_to_manager(to) {
+    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true) : m_from_manager(from), m_to_manager(to), m_from_read_only(from.is_read_only()) {
         m_loop_count = 0;
         m_hit_count = 0;
         m_miss_count = 0;
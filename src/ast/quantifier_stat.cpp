@@ -32,7 +32,14 @@ namespace q {
         m_num_instances_curr_search(0),
         m_num_instances_curr_branch(0),
         m_max_generation(0),
-        m_max_cost(0.0f) {
+        m_max_cost(0.0f),
+        m_num_matches(0),
+        m_num_conflicts(0),
+        m_last_conflict(0),
+        m_conflict_score(0.0),
+        m_matching_loop(false) {
+        for (unsigned & c : m_generation_histogram)
+            c = 0;
     }
 
     quantifier_stat_gen::quantifier_stat_gen(ast_manager & m, region & r):
@@ -22,6 +22,7 @@ Revision History:
 #include "util/obj_hashtable.h"
 #include "util/approx_nat.h"
 #include "util/region.h"
+#include "util/stopwatch.h"
 
 namespace q {
     
@@ -42,6 +43,13 @@ namespace q {
         unsigned m_num_instances_curr_branch; //!< only updated if QI_TRACK_INSTANCES is true
         unsigned m_max_generation; //!< max. generation of an instance
         float    m_max_cost;
+        unsigned m_num_matches;    //!< number of matches, including matches that were already instantiated.
+        unsigned m_num_conflicts;  //!< number of conflicts that used an instance, only updated if qi.profile or qi.throttle is true
+        unsigned m_last_conflict;
+        double   m_conflict_score; //!< activity of the quantifier in conflicts, only updated if qi.throttle is true
+        stopwatch m_instantiate_watch; //!< only updated if qi.profile is true
+        unsigned m_generation_histogram[8];
+        bool     m_matching_loop;
 
         friend class quantifier_stat_gen;
 
@@ -124,6 +132,80 @@ namespace q {
         float get_max_cost() const {
             return m_max_cost;
         }
+
+        void inc_num_matches() {
+            m_num_matches++;
+        }
+
+        unsigned get_num_matches() const {
+            return m_num_matches;
+        }
+
+        /**
+           \brief Record that an instance was used in the conflict with the given index.
+           Each conflict is counted once. Return false if the conflict was already counted.
+        */
+        bool inc_num_conflicts(unsigned conflict) {
+            if (m_num_conflicts > 0 && m_last_conflict == conflict)
+                return false;
+            m_last_conflict = conflict;
+            m_num_conflicts++;
+            return true;
+        }
+
+        unsigned get_num_conflicts() const {
+            return m_num_conflicts;
+        }
+
+        double get_conflict_score() const {
+            return m_conflict_score;
+        }
+
+        void add_conflict_score(double s) {
+            m_conflict_score += s;
+        }
+
+        void scale_conflict_score(double f) {
+            m_conflict_score *= f;
+        }
+
+        stopwatch & instantiate_watch() {
+            return m_instantiate_watch;
+        }
+
+        double get_instantiate_time() const {
+            return m_instantiate_watch.get_seconds();
+        }
+
+        static unsigned num_generation_buckets() {
+            return 8;
+        }
+
+        // buckets 0, 1, 2, 3, [4, 8), [8, 16), [16, 32), [32, oo)
+        static unsigned generation_bucket(unsigned g) {
+            if (g < 4)
+                return g;
+            unsigned b = 4;
+            for (g >>= 3; g > 0 && b < 7; g >>= 1)
+                ++b;
+            return b;
+        }
+
+        void inc_generation(unsigned g) {
+            m_generation_histogram[generation_bucket(g)]++;
+        }
+
+        unsigned get_generation_count(unsigned bucket) const {
+            return m_generation_histogram[bucket];
+        }
+
+        bool is_matching_loop() const {
+            return m_matching_loop;
+        }
+
+        void set_matching_loop() {
+            m_matching_loop = true;
+        }
     };
 
     /**
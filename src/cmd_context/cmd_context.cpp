@@ -623,6 +623,8 @@ cmd_context::~cmd_context() {
     if (m_main_ctx) {
         set_verbose_stream(std::cerr);
     }
+    if (m_manager && m_own_manager && m_params.m_bulk_release && !m_params.m_debug_ref_count)
+        m_manager->set_bulk_release();
     pop(m_scopes.size());
     finalize_cmds();
     finalize_tactic_manager();
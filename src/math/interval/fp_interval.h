@@ -0,0 +1,202 @@
+/*++
+  Copyright (c) 2025 Microsoft Corporation
+
+  Module Name:
+
+    fp_interval.h
+
+  Abstract:
+
+    Intervals over doubles with a running bound on the rounding error.
+
+    Each finite endpoint is a double together with an error radius:
+    the endpoint of the interval computed in exact arithmetic from the
+    same inputs lies within the radius of the double. This is enough to
+    decide some questions about the exact interval without computing it,
+    such as whether it certainly contains zero. Operations return false
+    when the result cannot be bounded, for instance on overflow or when
+    the sign of a factor of an infinite endpoint is not known.
+
+  --*/
+
+#pragma once
+#include <cfloat>
+#include <cmath>
+#include "util/rational.h"
+
+class fp_interval {
+public:
+    struct bound {
+        double m_val = 0;
+        double m_err = 0;
+        bool   m_inf = true;
+        // the exact value is certainly below (above) zero
+        bool is_neg() const { return m_inf ? m_val < 0 : m_val + m_err < 0; }
+        bool is_pos() const { return m_inf ? m_val > 0 : m_val - m_err > 0; }
+        bool is_zero() const { return !m_inf && m_val == 0 && m_err == 0; }
+    };
+
+private:
+    bound m_lower, m_upper;
+
+    static bool finish(double v, double err, bound& r) {
+        r.m_inf = false;
+        r.m_val = v;
+        // account for the rounding of v and of the error computation itself
+        r.m_err = (err + DBL_EPSILON * std::fabs(v) + DBL_MIN) * (1 + 8 * DBL_EPSILON);
+        return std::isfinite(r.m_val) && std::isfinite(r.m_err);
+    }
+
+    static bound inf(bool pos) {
+        bound r;
+        r.m_val = pos ? 1 : -1;
+        return r;
+    }
+
+    static bool add(bound const& a, bound const& b, bool upper, bound& r) {
+        if (a.m_inf || b.m_inf) {
+            r = inf(upper);
+            return true;
+        }
+        return finish(a.m_val + b.m_val, a.m_err + b.m_err, r);
+    }
+
+    static bool mul(bound const& a, bound const& b, bound& r) {
+        // 0 * inf = 0 as in the endpoint products of interval multiplication
+        if (a.is_zero() || b.is_zero()) {
+            r = bound();
+            r.m_inf = false;
+            return true;
+        }
+        if (a.m_inf || b.m_inf) {
+            bool a_pos = a.is_pos(), b_pos = b.is_pos();
+            if ((!a_pos && !a.is_neg()) || (!b_pos && !b.is_neg()))
+                return false;
+            r = inf(a_pos == b_pos);
+            return true;
+        }
+        double v = a.m_val * b.m_val;
+        double err = std::fabs(a.m_val) * b.m_err + std::fabs(b.m_val) * a.m_err + a.m_err * b.m_err;
+        return finish(v, err, r);
+    }
+
+    // the value of a bound, infinite bounds are compared by their sign
+    static double key(bound const& b) {
+        return b.m_inf ? (b.m_val > 0 ? HUGE_VAL : -HUGE_VAL) : b.m_val;
+    }
+
+    // the smallest (largest) of the bounds: the error of the result covers the errors of all of them
+    static bound extreme(bound const* bs, unsigned n, bool largest) {
+        bound r = bs[0];
+        double err = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            if (largest ? key(bs[i]) > key(r) : key(bs[i]) < key(r))
+                r = bs[i];
+            if (!bs[i].m_inf)
+                err = std::max(err, bs[i].m_err);
+        }
+        if (!r.m_inf)
+            r.m_err = err;
+        return r;
+    }
+
+public:
+    bound const& lower() const { return m_lower; }
+    bound const& upper() const { return m_upper; }
+
+    // the interval (-oo, oo)
+    void set_inf() {
+        m_lower = inf(false);
+        m_upper = inf(true);
+    }
+
+    static bool mk_bound(rational const& v, bound& r) {
+        if (v.is_big())
+            return false;
+        // numerator and denominator are exact, their quotient is rounded once
+        r.m_inf = false;
+        r.m_val = v.get_double();
+        r.m_err = v.is_int() ? 0 : 2 * DBL_EPSILON * std::fabs(r.m_val) + DBL_MIN;
+        return std::isfinite(r.m_val);
+    }
+
+    bool set_scalar(rational const& v) {
+        if (!mk_bound(v, m_lower))
+            return false;
+        m_upper = m_lower;
+        return true;
+    }
+
+    bool set_lower(rational const& v) { return mk_bound(v, m_lower); }
+    bool set_upper(rational const& v) { return mk_bound(v, m_upper); }
+    void set_lower_inf() { m_lower = inf(false); }
+    void set_upper_inf() { m_upper = inf(true); }
+
+    static bool add(fp_interval const& a, fp_interval const& b, fp_interval& r) {
+        return add(a.m_lower, b.m_lower, false, r.m_lower) && add(a.m_upper, b.m_upper, true, r.m_upper);
+    }
+
+    static bool mul(fp_interval const& a, fp_interval const& b, fp_interval& r) {
+        bound ps[4];
+        if (!mul(a.m_lower, b.m_lower, ps[0]) || !mul(a.m_lower, b.m_upper, ps[1]) ||
+            !mul(a.m_upper, b.m_lower, ps[2]) || !mul(a.m_upper, b.m_upper, ps[3]))
+            return false;
+        r.m_lower = extreme(ps, 4, false);
+        r.m_upper = extreme(ps, 4, true);
+        return true;
+    }
+
+    static bool mul(rational const& c, fp_interval const& a, fp_interval& r) {
+        fp_interval s;
+        return s.set_scalar(c) && mul(s, a, r);
+    }
+
+    static bool power(fp_interval const& a, unsigned p, fp_interval& r) {
+        SASSERT(p > 0);
+        bound lo = a.m_lower, hi = a.m_upper;
+        for (unsigned i = 1; i < p; ++i)
+            if (!mul(lo, a.m_lower, lo) || !mul(hi, a.m_upper, hi))
+                return false;
+        if (p % 2 == 1) {
+            r.m_lower = lo;
+            r.m_upper = hi;
+            return true;
+        }
+        if (!a.m_lower.is_neg() && !a.m_lower.is_zero() && !a.m_lower.is_pos())
+            return false; // the sign of the lower bound is not known
+        if (!a.m_upper.is_neg() && !a.m_upper.is_zero() && !a.m_upper.is_pos())
+            return false;
+        if (!a.m_lower.is_neg()) {
+            r.m_lower = lo;
+            r.m_upper = hi;
+        }
+        else if (!a.m_upper.is_pos()) {
+            r.m_lower = hi;
+            r.m_upper = lo;
+        }
+        else {
+            bound zero;
+            zero.m_inf = false;
+            r.m_lower = zero;
+            bound bs[2] = { lo, hi };
+            r.m_upper = extreme(bs, 2, true);
+        }
+        return true;
+    }
+
+    // intersection of a and b, fails unless it is certainly not empty
+    static bool intersect(fp_interval const& a, fp_interval const& b, fp_interval& r) {
+        bound los[2] = { a.m_lower, b.m_lower };
+        bound his[2] = { a.m_upper, b.m_upper };
+        r.m_lower = extreme(los, 2, true);
+        r.m_upper = extreme(his, 2, false);
+        if (r.m_lower.m_inf || r.m_upper.m_inf)
+            return true;
+        return r.m_lower.m_val + r.m_lower.m_err < r.m_upper.m_val - r.m_upper.m_err;
+    }
+
+    // zero is certainly an interior point of the exact interval
+    bool contains_zero() const {
+        return m_lower.is_neg() && m_upper.is_pos();
+    }
+};
@@ -0,0 +1,304 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.cpp
+
+Abstract:
+
+    Floating-point preconditioning for the exact simplex.
+
+--*/
+
+#include <cmath>
+#include "math/lp/float_simplex.h"
+
+namespace lp {
+
+    // coefficients outside of [s_min_coeff, s_max_coeff] are not represented faithfully enough
+    static const double s_min_coeff = 1e-9;
+    static const double s_max_coeff = 1e9;
+    // entries below s_drop_tol are treated as zero after a row operation
+    static const double s_drop_tol = 1e-11;
+    // smallest admissible pivot element
+    static const double s_pivot_tol = 1e-7;
+    // value used for the infinitesimal of strict bounds
+    static const double s_delta = 1e-6;
+    static const double s_feas_tol = 1e-9;
+
+    double float_simplex::to_double(numeric_pair<mpq> const& v) const {
+        return v.x.get_double() + s_delta * v.y.get_double();
+    }
+
+    bool float_simplex::init() {
+        unsigned m = m_s.m_m(), n = m_s.m_n();
+        m_rows.reset();
+        m_rows.resize(m);
+        m_cols.reset();
+        m_cols.resize(n);
+        m_basis.reset();
+        m_heading.assign(n, -1);
+        m_x.resize(n);
+        m_lo.resize(n);
+        m_hi.resize(n);
+        m_has_lo.resize(n);
+        m_has_hi.resize(n);
+        m_dense.resize(n, 0.0);
+        m_col_mark.resize(n, 0);
+        m_row_mark.resize(m, 0);
+        m_pivots = 0;
+        for (unsigned i = 0; i < m; ++i) {
+            unsigned b = m_s.m_basis[i];
+            m_basis.push_back(b);
+            m_heading[b] = i;
+            for (auto const& c : m_s.m_A.m_rows[i]) {
+                if (c.var() == b)
+                    continue;
+                double a = c.coeff().get_double();
+                double abs_a = std::fabs(a);
+                if (abs_a < s_min_coeff || abs_a > s_max_coeff)
+                    return false;
+                m_rows[i].push_back({ c.var(), a });
+                m_cols[c.var()].push_back(i);
+            }
+        }
+        for (unsigned j = 0; j < n; ++j) {
+            m_x[j] = to_double(m_s.m_x[j]);
+            column_type t = m_s.m_column_types[j];
+            m_has_lo[j] = t == column_type::lower_bound || t == column_type::boxed || t == column_type::fixed;
+            m_has_hi[j] = t == column_type::upper_bound || t == column_type::boxed || t == column_type::fixed;
+            m_lo[j] = m_has_lo[j] ? to_double(m_s.m_lower_bounds[j]) : 0;
+            m_hi[j] = m_has_hi[j] ? to_double(m_s.m_upper_bounds[j]) : 0;
+            if (!std::isfinite(m_x[j]) || !std::isfinite(m_lo[j]) || !std::isfinite(m_hi[j]))
+                return false;
+        }
+        return true;
+    }
+
+    bool float_simplex::is_feasible(unsigned j) const {
+        if (m_has_lo[j] && m_x[j] < m_lo[j] - s_feas_tol * (1 + std::fabs(m_lo[j])))
+            return false;
+        if (m_has_hi[j] && m_x[j] > m_hi[j] + s_feas_tol * (1 + std::fabs(m_hi[j])))
+            return false;
+        return true;
+    }
+
+    bool float_simplex::can_increase(unsigned j) const {
+        return !m_has_hi[j] || m_x[j] < m_hi[j] - s_feas_tol * (1 + std::fabs(m_hi[j]));
+    }
+
+    bool float_simplex::can_decrease(unsigned j) const {
+        return !m_has_lo[j] || m_x[j] > m_lo[j] + s_feas_tol * (1 + std::fabs(m_lo[j]));
+    }
+
+    // the row of the infeasible basic column with the smallest index, as in Bland's rule
+    int float_simplex::find_leaving_row() const {
+        int r = -1;
+        for (unsigned i = 0; i < m_basis.size(); ++i) {
+            unsigned b = m_basis[i];
+            if (!is_feasible(b) && (r == -1 || b < m_basis[r]))
+                r = i;
+        }
+        return r;
+    }
+
+    // x[b] = - sum of a_j * x[j]: to increase x[b] a column with a positive coefficient
+    // has to decrease and a column with a negative coefficient has to increase.
+    int float_simplex::find_entering(unsigned r, bool grow, double& a) const {
+        int entering = -1;
+        for (cell const& c : m_rows[r]) {
+            if (std::fabs(c.m_coeff) < s_pivot_tol)
+                continue;
+            bool dec = (c.m_coeff > 0) == grow;
+            if (dec ? !can_decrease(c.m_var) : !can_increase(c.m_var))
+                continue;
+            if (entering == -1 || c.m_var < static_cast<unsigned>(entering)) {
+                entering = c.m_var;
+                a = c.m_coeff;
+            }
+        }
+        return entering;
+    }
+
+    unsigned float_simplex::next_col_stamp() {
+        if (++m_col_stamp == 0) {
+            m_col_mark.fill(0);
+            m_col_stamp = 1;
+        }
+        return m_col_stamp;
+    }
+
+    // the rows containing column j with the coefficients of j, stale entries of m_cols[j] are removed
+    void float_simplex::collect_column(unsigned j) {
+        m_col.reset();
+        if (++m_row_stamp == 0) {
+            m_row_mark.fill(0);
+            m_row_stamp = 1;
+        }
+        unsigned_vector& rows = m_cols[j];
+        unsigned k = 0;
+        for (unsigned i : rows) {
+            if (m_row_mark[i] == m_row_stamp)
+                continue;
+            m_row_mark[i] = m_row_stamp;
+            for (cell const& c : m_rows[i]) {
+                if (c.m_var == j) {
+                    m_col.push_back({ i, c.m_coeff });
+                    rows[k++] = i;
+                    break;
+                }
+            }
+        }
+        rows.shrink(k);
+    }
+
+    // make column j basic in row r and eliminate it from the other rows of m_col
+    bool float_simplex::pivot(unsigned r, unsigned j) {
+        unsigned leaving = m_basis[r];
+        svector<cell>& row_r = m_rows[r];
+        double a = 0;
+        for (cell const& c : row_r)
+            if (c.m_var == j)
+                a = c.m_coeff;
+        SASSERT(a != 0);
+        // row r becomes x[j] + sum of c/a * x[var] + 1/a * x[leaving] = 0
+        unsigned k = 0;
+        for (cell const& c : row_r)
+            if (c.m_var != j)
+                row_r[k++] = { c.m_var, c.m_coeff / a };
+        row_r.shrink(k);
+        row_r.push_back({ leaving, 1 / a });
+        m_cols[leaving].push_back(r);
+        for (cell const& c : row_r)
+            m_dense[c.m_var] = c.m_coeff;
+
+        bool ok = true;
+        for (auto const& [i, f] : m_col) {
+            if (i == r)
+                continue;
+            // row_i := row_i - f * row_r, this eliminates column j
+            svector<cell>& row_i = m_rows[i];
+            unsigned stamp = next_col_stamp();
+            unsigned k = 0;
+            for (cell const& c : row_i) {
+                if (c.m_var == j)
+                    continue;
+                double v = c.m_coeff;
+                if (m_dense[c.m_var] != 0) {
+                    v -= f * m_dense[c.m_var];
+                    m_col_mark[c.m_var] = stamp;
+                }
+                if (std::fabs(v) > s_max_coeff)
+                    ok = false;
+                if (std::fabs(v) >= s_drop_tol)
+                    row_i[k++] = { c.m_var, v };
+            }
+            row_i.shrink(k);
+            for (cell const& c : row_r) {
+                if (m_col_mark[c.m_var] == stamp)
+                    continue;
+                double v = -f * c.m_coeff;
+                if (std::fabs(v) > s_max_coeff)
+                    ok = false;
+                if (std::fabs(v) >= s_drop_tol) {
+                    row_i.push_back({ c.m_var, v });
+                    m_cols[c.m_var].push_back(i);
+                }
+            }
+        }
+        for (cell const& c : row_r)
+            m_dense[c.m_var] = 0;
+        m_cols[j].reset();
+        m_cols[j].push_back(r);
+        m_basis[r] = j;
+        m_heading[j] = r;
+        m_heading[leaving] = -1;
+        ++m_pivots;
+        return ok;
+    }
+
+    void float_simplex::set_non_basic(unsigned j, numeric_pair<mpq> const& v) {
+        if (m_s.m_x[j] == v)
+            return;
+        numeric_pair<mpq> delta = v - m_s.m_x[j];
+        m_s.add_delta_to_x(j, delta);
+        for (auto const& c : m_s.m_A.m_columns[j])
+            m_s.add_delta_to_x(m_s.m_basis[c.var()], -delta * m_s.m_A.get_val(c));
+    }
+
+    // pivot the exact tableau to the floating-point basis, as far as the exact coefficients allow
+    void float_simplex::install_basis() {
+        for (unsigned j : m_basis) {
+            if (m_s.m_basis_heading[j] >= 0)
+                continue;
+            int row = -1;
+            for (auto const& c : m_s.m_A.m_columns[j]) {
+                unsigned b = m_s.m_basis[c.var()];
+                if (m_heading[b] < 0) {
+                    row = c.var();
+                    break;
+                }
+            }
+            if (row == -1)
+                continue;
+            unsigned leaving = m_s.m_basis[row];
+            if (!m_s.pivot_column_tableau(j, row))
+                continue;
+            m_s.change_basis(j, leaving);
+        }
+    }
+
+    // non-basic columns take the bound they have in the floating-point solution and
+    // have to be within their bounds in any case.
+    void float_simplex::move_non_basic_columns() {
+        for (unsigned j = 0; j < m_s.m_n(); ++j) {
+            if (m_s.m_basis_heading[j] >= 0)
+                continue;
+            column_type t = m_s.m_column_types[j];
+            bool has_lo = t == column_type::lower_bound || t == column_type::boxed || t == column_type::fixed;
+            bool has_hi = t == column_type::upper_bound || t == column_type::boxed || t == column_type::fixed;
+            if (has_lo && (m_s.m_x[j] < m_s.m_lower_bounds[j] || (m_heading[j] < 0 && !can_decrease(j))))
+                set_non_basic(j, m_s.m_lower_bounds[j]);
+            else if (has_hi && (m_s.m_x[j] > m_s.m_upper_bounds[j] || (m_heading[j] < 0 && !can_increase(j))))
+                set_non_basic(j, m_s.m_upper_bounds[j]);
+        }
+        m_s.clear_inf_heap();
+        for (unsigned b : m_s.m_basis)
+            if (!m_s.column_is_feasible(b))
+                m_s.insert_column_into_inf_heap(b);
+    }
+
+    bool float_simplex::operator()() {
+        if (!init())
+            return false;
+        unsigned max_pivots = 2 * (m_s.m_m() + m_s.m_n()) + 100;
+        while (m_pivots < max_pivots) {
+            if (m_s.m_settings.get_cancel_flag())
+                return false;
+            int r = find_leaving_row();
+            if (r == -1)
+                break;
+            unsigned b = m_basis[r];
+            bool grow = m_has_lo[b] && m_x[b] < m_lo[b];
+            double a = 0;
+            int j = find_entering(r, grow, a);
+            if (j == -1)
+                break; // infeasible row, the exact solver will find it again
+            double new_val = grow ? m_lo[b] : m_hi[b];
+            double theta = (m_x[b] - new_val) / a;
+            m_x[j] += theta;
+            collect_column(j);
+            for (auto const& [i, c] : m_col)
+                if (i != static_cast<unsigned>(r))
+                    m_x[m_basis[i]] -= c * theta;
+            m_x[b] = new_val;
+            if (!pivot(r, j) || !std::isfinite(m_x[j]))
+                return false;
+        }
+        TRACE(lar_solver, tout << "float simplex pivots: " << m_pivots << "\n";);
+        install_basis();
+        move_non_basic_columns();
+        return true;
+    }
+}
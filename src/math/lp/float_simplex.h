@@ -0,0 +1,79 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.h
+
+Abstract:
+
+    Floating-point preconditioning for the exact simplex.
+
+    The feasibility search of lp_primal_core_solver is first replayed on a
+    copy of the tableau in double precision. The basis found by the
+    floating-point search is then installed in the exact tableau by exact
+    pivots, and non-basic columns are moved to the bounds they take in the
+    floating-point solution. The exact solver runs from there and certifies
+    the result, so rounding errors only cost performance, never soundness.
+
+    The floating-point search is abandoned when the coefficients are too
+    large or too small to be represented faithfully, when a pivot element
+    gets too small, or when the tableau entries grow too much.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "math/lp/lp_primal_core_solver.h"
+
+namespace lp {
+
+    class float_simplex {
+        typedef lp_primal_core_solver<mpq, numeric_pair<mpq>> core_solver;
+
+        struct cell {
+            unsigned m_var;
+            double   m_coeff;
+        };
+
+        core_solver&           m_s;
+        vector<svector<cell>>  m_rows;      // row i: x[m_basis[i]] + sum of coeff * x[var] = 0
+        vector<unsigned_vector> m_cols;     // rows that may contain a column, can have stale entries
+        unsigned_vector        m_basis;
+        std_vector<int>        m_heading;   // row of a basic column, -1 for non-basic columns
+        svector<double>        m_x;
+        svector<double>        m_lo, m_hi;
+        bool_vector            m_has_lo, m_has_hi;
+        svector<double>        m_dense;     // scatter of the pivot row
+        svector<std::pair<unsigned, double>> m_col; // rows and coefficients of the entering column
+        unsigned_vector        m_row_mark, m_col_mark;
+        unsigned               m_row_stamp = 0, m_col_stamp = 0;
+        unsigned               m_pivots = 0;
+
+        bool init();
+        double to_double(numeric_pair<mpq> const& v) const;
+        bool is_feasible(unsigned j) const;
+        bool can_increase(unsigned j) const;
+        bool can_decrease(unsigned j) const;
+        int  find_leaving_row() const;
+        int  find_entering(unsigned r, bool grow, double& a) const;
+        bool pivot(unsigned r, unsigned j);
+        void collect_column(unsigned j);
+        unsigned next_col_stamp();
+        void install_basis();
+        void move_non_basic_columns();
+        void set_non_basic(unsigned j, numeric_pair<mpq> const& v);
+
+    public:
+        float_simplex(core_solver& s): m_s(s) {}
+
+        /**
+           \brief run the floating-point feasibility search and transfer its basis
+           to the exact solver. Return false if the search was abandoned, in which
+           case the exact solver is unchanged.
+        */
+        bool operator()();
+
+        unsigned num_pivots() const { return m_pivots; }
+    };
+}
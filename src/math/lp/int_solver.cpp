@@ -2,6 +2,8 @@
   Copyright (c) 2017 Microsoft Corporation
   Author: Lev Nachmanson
 */
+#include <algorithm>
+#include <cfloat>
 #include "math/lp/int_solver.h"
 #include "math/lp/lar_solver.h"
 #include "math/lp/lp_utils.h"
@@ -44,6 +46,16 @@ namespace lp {
         dioph_eq            m_dio;  
         int_gcd_test        m_gcd;
         unsigned            m_initial_dio_calls_period;
+
+        // cut strategies that are ordered by their success rate when lp.int_portfolio is set
+        enum cut_strategy { HNF_CUT = 0, GOMORY_CUT, DIOPH_EQ, NUM_CUT_STRATEGIES };
+        struct cut_strategy_info {
+            unsigned m_calls = 0;
+            unsigned m_success = 0;
+            uint64_t m_ticks = 0;
+            double rate() const { return m_calls == 0 ? DBL_MAX : (m_success + 1.0) / (m_ticks + 1); }
+        };
+        cut_strategy_info   m_cut_strategies[NUM_CUT_STRATEGIES];
         
         bool column_is_int_inf(unsigned j) const {
             return lra.column_is_int(j) && (!lia.value_is_int(j));
@@ -247,14 +259,69 @@ namespace lp {
             if (r == lia_move::undef) r = patch_basic_columns();
             if (r == lia_move::undef && should_find_cube()) r = int_cube(lia)();
             if (r == lia_move::undef) lra.move_non_basic_columns_to_bounds();
-            if (r == lia_move::undef && should_hnf_cut()) r = hnf_cut();
-            if (r == lia_move::undef && should_gomory_cut()) r = gomory(lia).get_gomory_cuts(2);
-            if (r == lia_move::undef && should_solve_dioph_eq()) r = solve_dioph_eq();
+            if (r == lia_move::undef) r = cut_strategies();
             if (r == lia_move::undef) r = int_branch(lia)();
             if (settings().get_cancel_flag()) r = lia_move::undef;        
             return r;
         }
 
+        bool should_run(cut_strategy s) {
+            switch (s) {
+            case HNF_CUT: return should_hnf_cut();
+            case GOMORY_CUT: return should_gomory_cut();
+            case DIOPH_EQ: return should_solve_dioph_eq();
+            default: UNREACHABLE(); return false;
+            }
+        }
+
+        lia_move run(cut_strategy s) {
+            switch (s) {
+            case HNF_CUT: return hnf_cut();
+            case GOMORY_CUT: return gomory(lia).get_gomory_cuts(2);
+            case DIOPH_EQ: return solve_dioph_eq();
+            default: UNREACHABLE(); return lia_move::undef;
+            }
+        }
+
+        // The effort of a call is measured in ticks, so the order of the strategies does not depend on timing:
+        // every strategy scans the rows of the tableau, and is charged for the simplex iterations it causes.
+        lia_move run_measured(cut_strategy s) {
+            cut_strategy_info& info = m_cut_strategies[s];
+            unsigned iterations = settings().stats().m_total_iterations;
+            lia_move r = run(s);
+            ++info.m_calls;
+            info.m_ticks += lra.A_r().row_count() + (settings().stats().m_total_iterations - iterations);
+            if (r != lia_move::undef) {
+                ++info.m_success;
+                ++settings().stats().m_int_portfolio_success;
+            }
+            return r;
+        }
+
+        /**
+           Try the cut strategies whose period has come, until one of them produces a move.
+           Without lp.int_portfolio they run in the fixed order hnf, gomory, dioph_eq.
+           Otherwise the strategies that produced the most moves per tick so far are tried first,
+           so the strategy that suits the problem at hand gets to run before the others.
+        */
+        lia_move cut_strategies() {
+            cut_strategy order[NUM_CUT_STRATEGIES] = { HNF_CUT, GOMORY_CUT, DIOPH_EQ };
+            if (settings().int_portfolio())
+                std::stable_sort(order, order + NUM_CUT_STRATEGIES, [&](cut_strategy a, cut_strategy b) {
+                    return m_cut_strategies[a].rate() > m_cut_strategies[b].rate();
+                });
+            for (cut_strategy s : order) {
+                if (!should_run(s))
+                    continue;
+                lia_move r = settings().int_portfolio() ? run_measured(s) : run(s);
+                if (r != lia_move::undef)
+                    return r;
+                if (settings().get_cancel_flag())
+                    return lia_move::undef;
+            }
+            return lia_move::undef;
+        }
+
         bool cut_indices_are_columns() const {
             for (lar_term::ival p : m_t) {
                 if (p.j() >= lra.A_r().column_count())
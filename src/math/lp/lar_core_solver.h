@@ -103,6 +103,8 @@ public:
 
     unsigned get_number_of_non_ints() const;
 
+    void run_float_simplex();
+
     void solve();
 
     void pivot(int entering, int leaving) { m_r_solver.pivot(entering, leaving); }
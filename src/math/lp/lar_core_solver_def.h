@@ -14,6 +14,7 @@ Revision History:
 #include <string>
 #include "util/vector.h"
 #include "math/lp/lar_core_solver.h"
+#include "math/lp/float_simplex.h"
 namespace lp {
 lar_core_solver::lar_core_solver(
     lp_settings & settings,
@@ -82,6 +83,18 @@ unsigned lar_core_solver::get_number_of_non_ints() const {
     return n;
 }
 
+void lar_core_solver::run_float_simplex() {
+    auto& st = m_r_solver.m_settings.stats();
+    ++st.m_float_simplex_calls;
+    float_simplex fs(m_r_solver);
+    if (!fs())
+        ++st.m_float_simplex_fallbacks;
+    st.m_float_simplex_pivots += fs.num_pivots();
+    SASSERT(m_r_solver.basis_heading_is_correct());
+    SASSERT(m_r_solver.non_basic_columns_are_set_correctly());
+    SASSERT(m_r_solver.inf_heap_is_correct());
+}
+
 void lar_core_solver::solve() {
     TRACE(lar_solver, tout << m_r_solver.get_status() << "\n";);
     SASSERT(m_r_solver.non_basic_columns_are_set_correctly());
@@ -95,6 +108,10 @@ void lar_core_solver::solve() {
     ++m_r_solver.m_settings.stats().m_need_to_solve_inf;
     SASSERT( r_basis_is_OK());
              
+    if (m_r_solver.m_look_for_feasible_solution_only && settings().float_simplex() && 
+        settings().use_tableau_rows() && m_m() >= settings().float_simplex_min_rows())
+        run_float_simplex();
+
     if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
          m_r_solver.find_feasible_solution();
     else 
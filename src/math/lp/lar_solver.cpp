@@ -14,6 +14,14 @@ namespace lp {
         impq m_bound;
         column m_column;
     };
+
+    // positions in a row of two columns that are unbounded from above and of two
+    // columns that are unbounded from below, with respect to the sign of their coefficient.
+    // UINT_MAX stands for a missing watch.
+    struct row_watch {
+        unsigned m_above[2] = { UINT_MAX, UINT_MAX };
+        unsigned m_below[2] = { UINT_MAX, UINT_MAX };
+    };
     
     struct lar_solver::imp {
         struct undo_add_column;
@@ -55,6 +63,7 @@ namespace lp {
         constraint_set m_constraints;
         indexed_uint_set m_columns_with_changed_bounds;
         indexed_uint_set m_touched_rows;
+        svector<row_watch> m_row_watches;
         unsigned_vector m_row_bounds_to_replay;
         u_dependency_manager m_dependencies;
         svector<constraint_index> m_tmp_dependencies;
@@ -150,18 +159,13 @@ namespace lp {
             const mpq& key = bound.x;
             unsigned k;
             bool j_is_int = lra.column_is_int(j);
-            if (j_is_int) {
-                if (!m_fixed_var_table_int.find(key, k)) {
-                    m_fixed_var_table_int.insert(key, j);
-                    return;
-                }
-            }
-            else { // j is not integral column        
-                if (!m_fixed_var_table_real.find(key, k)) {
-                m_fixed_var_table_real.insert(key, j);
+            auto& table = j_is_int ? m_fixed_var_table_int : m_fixed_var_table_real;
+            if (!table.find(key, k)) {
+                // the entry is removed when the scope that fixed j is popped
+                table.insert(key, j);
+                m_trail.push(insert_map<map<mpq, unsigned, obj_hash<mpq>, default_eq<mpq>>, mpq>(table, key));
                 return;
             }
-            }
 
             CTRACE(arith, !lra.column_is_fixed(k), lra.print_terms(tout););
             // SASSERT(column_is_fixed(k));
@@ -373,6 +377,56 @@ namespace lp {
         return false;
     }
 
+    // The monoid a*x[j] at position k of row is unbounded from above (below): the bound
+    // analyzer cannot use it to bound the other monoids from below (above).
+    bool lar_solver::watched_column_is_unbounded(row_strip<mpq> const& row, unsigned k, bool from_above) const {
+        if (k >= row.size())
+            return false;
+        auto const& c = row[k];
+        switch (get_column_type(c.var())) {
+        case column_type::free_column:
+            return true;
+        case column_type::lower_bound:
+            return is_pos(c.coeff()) == from_above;
+        case column_type::upper_bound:
+            return is_neg(c.coeff()) == from_above;
+        default:
+            return false;
+        }
+    }
+
+    /**
+       A row with at least two monoids unbounded from above and two monoids unbounded from below
+       does not imply any bound. The positions of such monoids are watched, so that a touched row
+       is only scanned again when one of its watched columns got a bound or was pivoted out of the row.
+       The watches are validated against the current content of the row, so they never need to be
+       reset on backtracking or pivoting.
+    */
+    bool lar_solver::row_is_blocked_for_bound_propagation(unsigned i) {
+        auto& watches = m_imp->m_row_watches;
+        if (i >= watches.size())
+            watches.resize(A_r().row_count());
+        row_watch& w = watches[i];
+        auto const& row = A_r().m_rows[i];
+        if (watched_column_is_unbounded(row, w.m_above[0], true) && watched_column_is_unbounded(row, w.m_above[1], true) &&
+            watched_column_is_unbounded(row, w.m_below[0], false) && watched_column_is_unbounded(row, w.m_below[1], false)) {
+            ++stats().m_bprop_rows_skipped;
+            return true;
+        }
+        w = row_watch();
+        unsigned na = 0, nb = 0;
+        for (unsigned k = 0; k < row.size() && (na < 2 || nb < 2); ++k) {
+            if (na < 2 && watched_column_is_unbounded(row, k, true))
+                w.m_above[na++] = k;
+            if (nb < 2 && watched_column_is_unbounded(row, k, false))
+                w.m_below[nb++] = k;
+        }
+        if (na < 2 || nb < 2)
+            return false;
+        ++stats().m_bprop_rows_skipped;
+        return true;
+    }
+
     lp_status lar_solver::get_status() const { return m_imp->m_status; }
 
     void lar_solver::set_status(lp_status s) {
@@ -563,7 +617,6 @@ namespace lp {
         TRACE(lar_solver_details, for (unsigned j = 0; j < n; j++) print_column_info(j, tout) << "\n";);
 
         get_core_solver().pop(k);
-        remove_non_fixed_from_fixed_var_table();
 
         for (auto rid : m_imp->m_row_bounds_to_replay)
             add_touched_row(rid);
@@ -2081,24 +2134,6 @@ namespace lp {
         return ci;
     }
 
-    template <typename T>
-    void lar_solver::remove_non_fixed_from_table(T& table) {
-        vector<mpq> to_remove;
-        for (const auto& p : table) {
-            unsigned j = p.m_value;
-            if (j >= column_count() || !column_is_fixed(j))
-                to_remove.push_back(p.m_key);
-        }
-        for (const auto& p : to_remove)
-            table.erase(p);
-    }
-
-    void lar_solver::remove_non_fixed_from_fixed_var_table() {
-        remove_non_fixed_from_table(m_imp->m_fixed_var_table_int);
-        remove_non_fixed_from_table(m_imp->m_fixed_var_table_real);
-    }
-
-
     void lar_solver::activate_check_on_equal(constraint_index ci, unsigned& equal_column) {
         auto const& c = m_imp->m_constraints[ci];
         update_column_type_and_bound_check_on_equal(c.column(), c.rhs(), ci, equal_column);
@@ -2113,18 +2148,18 @@ namespace lp {
         if (!column_is_int(j))
             return bound;
         if (bound.is_int())
-            return bound;
+            return adjust_bound_for_term_gcd(j, k, bound);
         switch (k) {
         case LT:
             k = LE;
             Z3_fallthrough;
         case LE:
-            return floor(bound);
+            return adjust_bound_for_term_gcd(j, k, floor(bound));
         case GT:
             k = GE;
             Z3_fallthrough;
         case GE:
-            return ceil(bound);
+            return adjust_bound_for_term_gcd(j, k, ceil(bound));
         case EQ:
             return bound;
         default:
@@ -2135,6 +2170,29 @@ namespace lp {
 
     }
 
+    // If j is a term with integer coefficients over integer columns then every value of j is a
+    // multiple of the gcd g of the coefficients: j <= b is tightened to j <= floor(b/g)*g and
+    // j >= b to j >= ceil(b/g)*g. The tightened bound has the same explanation and the same models.
+    mpq lar_solver::adjust_bound_for_term_gcd(lpvar j, lconstraint_kind k, const mpq& bound) {
+        if (!settings().term_gcd_bounds() || (k != LE && k != GE) || !column_has_term(j))
+            return bound;
+        mpq g(0);
+        for (lar_term::ival p : get_term(j)) {
+            if (!p.coeff().is_int() || !column_is_int(p.j()))
+                return bound;
+            g = gcd(g, p.coeff());
+            if (g.is_one())
+                return bound;
+        }
+        if (g.is_zero())
+            return bound;
+        mpq q = bound / g;
+        if (q.is_int())
+            return bound;
+        ++stats().m_term_gcd_bounds;
+        return (k == LE ? floor(q) : ceil(q)) * g;
+    }
+
     constraint_index lar_solver::mk_var_bound(lpvar j, lconstraint_kind kind, const mpq& right_side) {
         TRACE(lar_solver, tout << "j = " << get_variable_name(j) << " " << lconstraint_kind_string(kind) << " " << right_side << std::endl;);
         constraint_index ci;
@@ -55,6 +55,8 @@ class lar_solver : public column_namer {
     ////////////////// methods ////////////////////////////////
 
     bool row_has_a_big_num(unsigned i) const;
+    bool watched_column_is_unbounded(row_strip<mpq> const& row, unsigned k, bool from_above) const;
+    bool row_is_blocked_for_bound_propagation(unsigned i);
     // init region
     void register_new_external_var(unsigned ext_v, bool is_int);
     bool term_is_int(const lar_term* t) const;
@@ -62,6 +64,7 @@ class lar_solver : public column_namer {
     void add_non_basic_var_to_core_fields(unsigned ext_j, bool is_int);
     void add_new_var_to_core_fields_for_mpq(bool register_in_basis);
     mpq adjust_bound_for_int(lpvar j, lconstraint_kind&, const mpq&);
+    mpq adjust_bound_for_term_gcd(lpvar j, lconstraint_kind, const mpq&);
 
     // terms
     bool all_vars_are_registered(const vector<std::pair<mpq, lpvar>>& coeffs);
@@ -102,7 +105,6 @@ class lar_solver : public column_namer {
     void update_bound_with_no_ub_lb(lpvar j, lconstraint_kind kind, const mpq& right_side, u_dependency* dep);
     void update_bound_with_ub_no_lb(lpvar j, lconstraint_kind kind, const mpq& right_side, u_dependency* dep);
     void update_bound_with_no_ub_no_lb(lpvar j, lconstraint_kind kind, const mpq& right_side, u_dependency* dep);
-    void remove_non_fixed_from_fixed_var_table();
     constraint_index add_var_bound_on_constraint_for_term(lpvar j, lconstraint_kind kind, const mpq& right_side);
     void set_crossed_bounds_column_and_deps(unsigned j, bool lower_bound, u_dependency* dep);
     unsigned row_of_basic_column(unsigned) const;
@@ -111,8 +113,13 @@ class lar_solver : public column_namer {
 
     template <typename T>
     unsigned calculate_implied_bounds_for_row(unsigned row_index, lp_bound_propagator<T>& bp) {
-        if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation || row_has_a_big_num(row_index))
+        if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation)
             return 0;
+        if (settings().bprop_watch_rows() && row_is_blocked_for_bound_propagation(row_index))
+            return 0;
+        if (row_has_a_big_num(row_index))
+            return 0;
+        ++stats().m_bprop_rows_analyzed;
 
         return bound_analyzer_on_row<row_strip<mpq>, lp_bound_propagator<T>>::analyze_row(
             A_r().m_rows[row_index],
@@ -195,9 +202,6 @@ public:
         return is_int ? fixed_var_table_int().find(mpq, j) : fixed_var_table_real().find(mpq, j);
     }
 
-    template <typename T>
-    void remove_non_fixed_from_table(T&);
-
     bool inside_bounds(lpvar, const impq&) const;
 
     void set_column_value(unsigned j, const impq& v);
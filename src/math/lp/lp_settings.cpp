@@ -41,4 +41,9 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     m_dio_ignore_big_nums = lp_p.dio_ignore_big_nums();
     m_dio_calls_period = lp_p.dio_calls_period();
     m_dio_run_gcd = lp_p.dio_run_gcd();
+    m_float_simplex = lp_p.float_simplex();
+    m_float_simplex_min_rows = lp_p.float_simplex_min_rows();
+    m_bprop_watch_rows = lp_p.bprop_watch_rows();
+    m_int_portfolio = lp_p.int_portfolio();
+    m_term_gcd_bounds = lp_p.term_gcd_bounds();
 }
@@ -127,6 +127,7 @@ struct statistics {
     unsigned m_horner_calls = 0;
     unsigned m_horner_conflicts = 0;
     unsigned m_cross_nested_forms = 0;
+    unsigned m_cross_nested_fp_filtered = 0;
     unsigned m_grobner_calls = 0;
     unsigned m_grobner_conflicts = 0;
     unsigned m_offset_eqs = 0;
@@ -136,6 +137,13 @@ struct statistics {
     unsigned m_dio_rewrite_conflicts = 0;
     unsigned m_bounds_tightening_conflicts = 0;
     unsigned m_bounds_tightenings = 0;
+    unsigned m_float_simplex_calls = 0;
+    unsigned m_float_simplex_pivots = 0;
+    unsigned m_float_simplex_fallbacks = 0;
+    unsigned m_bprop_rows_skipped = 0;
+    unsigned m_bprop_rows_analyzed = 0;
+    unsigned m_int_portfolio_success = 0;
+    unsigned m_term_gcd_bounds = 0;
     ::statistics m_st = {};
 
     void reset() {
@@ -158,6 +166,7 @@ struct statistics {
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
+        st.update("arith-horner-fp-filtered", m_cross_nested_fp_filtered);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
         st.update("arith-offset-eqs", m_offset_eqs);
@@ -173,6 +182,13 @@ struct statistics {
         st.update("arith-dio-rewrite-conflicts", m_dio_rewrite_conflicts);
         st.update("arith-bounds-tightening-conflicts", m_bounds_tightening_conflicts);
         st.update("arith-bounds-tightenings", m_bounds_tightenings);
+        st.update("arith-float-simplex-calls", m_float_simplex_calls);
+        st.update("arith-float-simplex-pivots", m_float_simplex_pivots);
+        st.update("arith-float-simplex-fallbacks", m_float_simplex_fallbacks);
+        st.update("arith-bprop-rows-skipped", m_bprop_rows_skipped);
+        st.update("arith-bprop-rows-analyzed", m_bprop_rows_analyzed);
+        st.update("arith-lia-portfolio-moves", m_int_portfolio_success);
+        st.update("arith-term-gcd-bounds", m_term_gcd_bounds);
         st.copy(m_st);
     }
 };
@@ -252,7 +268,17 @@ private:
     bool             m_dio_ignore_big_nums = false;
     unsigned         m_dio_calls_period = 4;
     bool             m_dio_run_gcd = true;
+    bool             m_float_simplex = false;
+    unsigned         m_float_simplex_min_rows = 50;
+    bool             m_bprop_watch_rows = true;
+    bool             m_int_portfolio = false;
+    bool             m_term_gcd_bounds = false;
 public:
+    bool term_gcd_bounds() const { return m_term_gcd_bounds; }
+    bool int_portfolio() const { return m_int_portfolio; }
+    bool bprop_watch_rows() const { return m_bprop_watch_rows; }
+    bool float_simplex() const { return m_float_simplex; }
+    unsigned float_simplex_min_rows() const { return m_float_simplex_min_rows; }
     unsigned dio_calls_period() const { return m_dio_calls_period; }
     unsigned & dio_calls_period() { return m_dio_calls_period; }
     bool print_external_var_name() const { return m_print_external_var_name; }
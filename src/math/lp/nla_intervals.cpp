@@ -87,6 +87,13 @@ std::ostream& intervals::display_separating_interval(std::ostream& out, const ne
 // return true iff the interval of n is does not contain 0
 bool intervals::check_nex(const nex* n, u_dependency* initial_deps) {
     m_core->lp_settings().stats().m_cross_nested_forms++;
+    if (m_core->params().arith_nl_horner_fp_intervals()) {
+        fp_interval fi;
+        if (fp_interval_of_expr(n, 1, fi) && fi.contains_zero()) {
+            m_core->lp_settings().stats().m_cross_nested_fp_filtered++;
+            return false;
+        }
+    }
     scoped_dep_interval i(get_dep_intervals());
     std::function<void (const lp::explanation&)> f = [this](const lp::explanation& e) {
         new_lemma lemma(*m_core, "check_nex");
@@ -472,6 +479,111 @@ bool intervals::interval_of_expr(const nex* e, unsigned p, scoped_dep_interval&
 }
 
 
+// Floating-point counterparts of the functions above. They over-approximate the rounding errors,
+// so that a floating-point interval certainly containing zero means that the exact interval of
+// the expression contains zero. They return false when the computation is inconclusive, including
+// the cases where the exact computation finds a conflict.
+
+bool intervals::fp_var_interval(lpvar v, fp_interval& b) const {
+    u_dependency* dep = nullptr;
+    rational val;
+    bool is_strict;
+    if (ls().has_lower_bound(v, dep, val, is_strict)) {
+        if (!b.set_lower(val))
+            return false;
+    }
+    else
+        b.set_lower_inf();
+    if (ls().has_upper_bound(v, dep, val, is_strict)) {
+        if (!b.set_upper(val))
+            return false;
+    }
+    else
+        b.set_upper_inf();
+    return true;
+}
+
+bool intervals::fp_interval_from_term(const nex& e, fp_interval& i) {
+    rational a, b;
+    lp::lar_term norm_t = expression_to_normalized_term(&e.to_sum(), a, b);
+    lp::explanation exp;
+    if (m_core->explain_by_equiv(norm_t, exp))
+        return i.set_scalar(b);
+    lpvar j = find_term_column(norm_t, a);
+    if (j + 1 == 0) {
+        i.set_inf();
+        return true;
+    }
+    fp_interval vi, ai, bi;
+    return fp_var_interval(j, vi) && fp_interval::mul(a, vi, ai) && bi.set_scalar(b) && fp_interval::add(ai, bi, i);
+}
+
+bool intervals::fp_interval_of_sum(const nex_sum& e, fp_interval& a) {
+    if (has_inf_interval(e))
+        a.set_inf();
+    else {
+        if (!fp_interval_of_expr(e[0], 1, a))
+            return false;
+        for (unsigned k = 1; k < e.size(); k++) {
+            fp_interval b, c;
+            if (!fp_interval_of_expr(e[k], 1, b) || !fp_interval::add(a, b, c))
+                return false;
+            a = c;
+        }
+    }
+    if (e.is_a_linear_term()) {
+        fp_interval t, r;
+        if (!fp_interval_from_term(e, t) || !fp_interval::intersect(a, t, r))
+            return false;
+        a = r;
+    }
+    return true;
+}
+
+bool intervals::fp_interval_of_mul(const nex_mul& e, fp_interval& a) {
+    const nex* zero_interval_child = get_zero_interval_child(e);
+    if (zero_interval_child)
+        return fp_interval_of_expr(zero_interval_child, 1, a);
+    if (!a.set_scalar(e.coeff()))
+        return false;
+    for (const auto& ep : e) {
+        fp_interval b, c;
+        if (!fp_interval_of_expr(ep.e(), ep.pow(), b) || !fp_interval::mul(a, b, c))
+            return false;
+        a = c;
+    }
+    return true;
+}
+
+bool intervals::fp_interval_of_expr(const nex* e, unsigned p, fp_interval& a) {
+    switch (e->type()) {
+    case expr_type::SCALAR:
+        return a.set_scalar(power(to_scalar(e)->value(), p));
+    case expr_type::SUM:
+        if (!fp_interval_of_sum(e->to_sum(), a))
+            return false;
+        break;
+    case expr_type::MUL:
+        if (!fp_interval_of_mul(e->to_mul(), a))
+            return false;
+        break;
+    case expr_type::VAR:
+        if (!fp_var_interval(e->to_var().var(), a))
+            return false;
+        break;
+    default:
+        UNREACHABLE();
+        return false;
+    }
+    if (p == 1)
+        return true;
+    fp_interval b;
+    if (!fp_interval::power(a, p, b))
+        return false;
+    a = b;
+    return true;
+}
+
 lp::lar_solver& intervals::ls() { return m_core->lra; }
 
 const lp::lar_solver& intervals::ls() const { return m_core->lra; }
@@ -13,6 +13,7 @@
 #include "math/lp/lar_solver.h"
 #include "math/interval/interval.h"
 #include "math/interval/dep_intervals.h"
+#include "math/interval/fp_interval.h"
 #include "util/dependency.h"
 
 namespace nla {
@@ -76,6 +77,11 @@ public:
     bool is_inf(const interval& i) const { return m_dep_intervals.is_inf(i); }
 
     bool check_nex(const nex*, u_dependency*);
+    bool fp_var_interval(lpvar v, fp_interval& b) const;
+    bool fp_interval_from_term(const nex& e, fp_interval& i);
+    bool fp_interval_of_sum(const nex_sum& e, fp_interval& a);
+    bool fp_interval_of_mul(const nex_mul& e, fp_interval& a);
+    bool fp_interval_of_expr(const nex* e, unsigned p, fp_interval& a);
     const nex* get_zero_interval_child(const nex_mul&) const;
     const nex* get_inf_interval_child(const nex_sum&) const;
     bool has_zero_interval(const nex&) const;
@@ -41,6 +41,8 @@ namespace lp {
     template void static_matrix<mpq, mpq>::init_row_columns(unsigned int, unsigned int);
     template static_matrix<mpq, mpq>::ref& static_matrix<mpq, mpq>::ref::operator=(mpq const&);
     template void static_matrix<mpq, mpq>::set(unsigned int, unsigned int, mpq const&);
+    template void static_matrix<mpq, mpq>::add_new_element(unsigned int, unsigned int, mpq const&);
+    template void static_matrix<mpq, mpq>::add_new_element(unsigned int, unsigned int, mpq&&);
 
     template static_matrix<mpq, mpq>::static_matrix(unsigned int, unsigned int);
 #ifdef Z3DEBUG
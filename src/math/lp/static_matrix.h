@@ -23,6 +23,8 @@ class row_cell {
 public:
     row_cell(unsigned j, unsigned offset, T const & val) : m_j(j), m_offset(offset), m_coeff(val) {
     }
+    row_cell(unsigned j, unsigned offset, T && val) : m_j(j), m_offset(offset), m_coeff(std::move(val)) {
+    }
     row_cell(unsigned j, unsigned offset) : m_j(j), m_offset(offset) {
     }
     inline const T & coeff() const { return m_coeff; }
@@ -126,6 +128,7 @@ public:
     unsigned lowest_row_in_column(unsigned col);
 
     void add_new_element(unsigned i, unsigned j, const T & v);
+    void add_new_element(unsigned i, unsigned j, T && v);
 
     // adds row i muliplied by coeff to row k
     void add_rows(const mpq& coeff, unsigned i, unsigned k);
@@ -296,9 +299,7 @@ public:
     bool pivot_row_to_row_given_cell(unsigned i, column_cell& c, unsigned j);
     void pivot_row_to_row_given_cell_with_sign(unsigned piv_row_index, column_cell& c, unsigned j, int j_sign);
     void transpose_rows(unsigned i, unsigned ii) {
-        auto t = m_rows[i];
-        m_rows[i] = m_rows[ii];
-        m_rows[ii] = t;
+        m_rows[i].swap(m_rows[ii]);
         // now fix the columns
         for (auto & rc : m_rows[i]) {
             column_cell & cc = m_columns[rc.var()][rc.offset()];
@@ -65,8 +65,7 @@ namespace lp {
             SASSERT(!is_zero(iv.coeff()));
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
-                add_new_element(ii, j, alv);
+                add_new_element(ii, j, alpha * iv.coeff());
             }
             else {
                 addmul(rowii[j_offs].coeff(), iv.coeff(), alpha);
@@ -96,8 +95,7 @@ namespace lp {
             unsigned j = iv.var();
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
-                add_new_element(k, j, alv);
+                add_new_element(k, j, alpha * iv.coeff());
             }
             else {
                 addmul(rowk[j_offs].coeff(), iv.coeff(), alpha);
@@ -134,8 +132,7 @@ namespace lp {
             SASSERT(!is_zero(iv.coeff()));
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
-                add_new_element(ii, j, alv);
+                add_new_element(ii, j, alpha * iv.coeff());
             }
             else {
                 addmul(rowii[j_offs].coeff(), iv.coeff(), alpha);
@@ -167,8 +164,7 @@ namespace lp {
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
                 add_columns_up_to(j);
-                T alv = alpha * iv.coeff();
-                add_new_element(ii, j, alv);
+                add_new_element(ii, j, alpha * iv.coeff());
             }
             else {
                 addmul(rowii[j_offs].coeff(), iv.coeff(), alpha);
@@ -203,8 +199,7 @@ namespace lp {
             SASSERT(!is_zero(iv.coeff()));
             int j_offs = m_work_vector_of_row_offsets[j];
             if (j_offs == -1) { // it is a new element
-                T alv = alpha * iv.coeff();
-                add_new_element(ii, j, alv);
+                add_new_element(ii, j, alpha * iv.coeff());
             }
             else {
                 addmul(rowii[j_offs].coeff(), iv.coeff(), alpha);
@@ -467,7 +462,7 @@ namespace lp {
         }
     
         if (row_offset != row_vals.size() - 1) {
-            auto & rc = row_vals[row_offset] = row_vals.back(); // copy from the tail
+            auto & rc = row_vals[row_offset] = std::move(row_vals.back()); // move from the tail
             m_columns[rc.var()][rc.offset()].offset() = row_offset;
         }
 
@@ -485,4 +480,14 @@ namespace lp {
         col_vals.push_back(column_cell(row, row_el_offs));
     }
 
+    template <typename T, typename X>
+    void static_matrix<T, X>::add_new_element(unsigned row, unsigned col, T&& val) {
+        auto & row_vals = m_rows[row];
+        auto & col_vals = m_columns[col];
+        unsigned row_el_offs = static_cast<unsigned>(row_vals.size());
+        unsigned col_el_offs = static_cast<unsigned>(col_vals.size());
+        row_vals.emplace_back(col, col_el_offs, std::move(val));
+        col_vals.push_back(column_cell(row, row_el_offs));
+    }
+
 }
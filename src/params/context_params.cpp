@@ -106,6 +106,9 @@ void context_params::set(char const * param, char const * value) {
     else if (p == "debug_ref_count") {
         set_bool(m_debug_ref_count, param, value);
     }
+    else if (p == "bulk_release") {
+        set_bool(m_bulk_release, param, value);
+    }
     else if (p == "smtlib2_compliant") {
         set_bool(m_smtlib2_compliant, param, value);
     }
@@ -149,6 +152,7 @@ void context_params::updt_params(params_ref const & p) {
     m_dot_proof_file    = p.get_str("dot_proof_file", "proof.dot");
     m_unsat_core        |= p.get_bool("unsat_core", m_unsat_core);
     m_debug_ref_count   = p.get_bool("debug_ref_count", m_debug_ref_count);
+    m_bulk_release      = p.get_bool("bulk_release", m_bulk_release);
     m_smtlib2_compliant = p.get_bool("smtlib2_compliant", m_smtlib2_compliant);
     m_statistics        = p.get_bool("stats", m_statistics);
     m_encoding          = p.get_str("encoding", m_encoding.c_str());
@@ -167,6 +171,7 @@ void context_params::collect_param_descrs(param_descrs & d) {
     d.insert("trace_file_name", CPK_STRING, "trace out file name (see option 'trace')", "z3.log");
     d.insert("dot_proof_file", CPK_STRING, "file in which to output graphical proofs", "proof.dot");
     d.insert("debug_ref_count", CPK_BOOL, "debug support for AST reference counting", "false");
+    d.insert("bulk_release", CPK_BOOL, "release all terms at once when a context is deleted instead of freeing them one by one", "false");
     d.insert("smtlib2_compliant", CPK_BOOL, "enable/disable SMT-LIB 2.0 compliance", "false");
     d.insert("stats", CPK_BOOL, "enable/disable statistics", "false");
     d.insert("encoding", CPK_STRING, "string encoding used internally: unicode|bmp|ascii", "unicode");
@@ -35,6 +35,7 @@ public:
     bool             m_auto_config { true };
     bool             m_proof { false };
     bool             m_debug_ref_count { false };
+    bool             m_bulk_release { false };
     bool             m_trace { false };
     bool             m_well_sorted_check { false };
     bool             m_model { true };
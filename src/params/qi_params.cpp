@@ -18,6 +18,7 @@ Revision History:
 --*/
 #include "params/qi_params.h"
 #include "params/smt_params_helper.hpp"
+#include "util/z3_exception.h"
 
 void qi_params::updt_params(params_ref const & _p) {
     smt_params_helper p(_p);
@@ -31,11 +32,17 @@ void qi_params::updt_params(params_ref const & _p) {
     m_qe_lite = p.q_lite();
     m_qi_profile = p.qi_profile();
     m_qi_profile_freq = p.qi_profile_freq();
+    m_qi_profile_file = p.qi_profile_file();
     m_qi_max_instances = p.qi_max_instances();
     m_qi_eager_threshold = p.qi_eager_threshold();
     m_qi_lazy_threshold = p.qi_lazy_threshold();
     m_qi_cost = p.qi_cost();
     m_qi_max_eager_multipatterns = p.qi_max_multi_patterns();
+    m_qi_ematching_threads = p.qi_ematching_threads();
+    m_qi_throttle = p.qi_throttle();
+    m_qi_throttle_decay = p.qi_throttle_decay();
+    if (!(m_qi_throttle_decay > 0 && m_qi_throttle_decay <= 1)) throw default_exception("qi.throttle_decay must be in (0, 1]");
+    m_qi_throttle_penalty = p.qi_throttle_penalty();
     m_qi_quick_checker = static_cast<quick_checker_mode>(p.qi_quick_checker());
 }
 
@@ -48,8 +55,13 @@ void qi_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_qi_lazy_threshold);
     DISPLAY_PARAM(m_qi_max_eager_multipatterns);
     DISPLAY_PARAM(m_qi_max_lazy_multipattern_matching);
+    DISPLAY_PARAM(m_qi_ematching_threads);
+    DISPLAY_PARAM(m_qi_throttle);
+    DISPLAY_PARAM(m_qi_throttle_decay);
+    DISPLAY_PARAM(m_qi_throttle_penalty);
     DISPLAY_PARAM(m_qi_profile);
     DISPLAY_PARAM(m_qi_profile_freq);
+    DISPLAY_PARAM(m_qi_profile_file);
     DISPLAY_PARAM(m_qi_quick_checker);
     DISPLAY_PARAM(m_qi_lazy_quick_checker);
     DISPLAY_PARAM(m_qi_promote_unsat);
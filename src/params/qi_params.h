@@ -34,8 +34,13 @@ struct qi_params {
     double             m_qi_lazy_threshold = 20.0;
     unsigned           m_qi_max_eager_multipatterns = 0;
     unsigned           m_qi_max_lazy_multipattern_matching = 2;
+    unsigned           m_qi_ematching_threads = 1;
+    bool               m_qi_throttle = false;
+    double             m_qi_throttle_decay = 0.95;
+    double             m_qi_throttle_penalty = 10.0;
     bool               m_qi_profile = false;
     unsigned           m_qi_profile_freq = UINT_MAX;
+    std::string        m_qi_profile_file;
     quick_checker_mode m_qi_quick_checker = MC_NO;
     bool               m_qi_lazy_quick_checker = true;
     bool               m_qi_promote_unsat = true;
@@ -443,6 +443,8 @@ namespace sat {
         // check if the clause is already satisfied
         for (i = 0; i < sz; i++) {
             if (s.value(c[i]) == l_true) {
+                if (!s.can_delete(c))
+                    return true;
                 s.detach_clause(c);
                 s.del_clause(c);
                 return false;
@@ -470,6 +472,96 @@ namespace sat {
         }
     }
     
+    void asymm_branch::vivify_learned() {
+        m_vivify_pending = false;
+        if (!m_vivify || s.inconsistent())
+            return;
+        SASSERT(s.at_base_lvl());
+        s.propagate(false);
+        if (s.inconsistent())
+            return;
+        uint64_t budget = (m_ticks - m_vivify_ticks) * m_vivify_effort / 100;
+        uint64_t start = m_ticks;
+        int64_t counter = m_counter;
+        unsigned eliml0 = m_elim_learned_literals;
+        ++m_vivify_calls;
+        bool_vector saved_phase(s.m_phase);
+        flet<bool> _is_probing(s.m_is_probing, true);
+        clause_vector& clauses = s.m_learned;
+        unsigned j = 0, sz = clauses.size(), i = 0;
+        try {
+            for (; i < sz; ++i) {
+                clause& c = *clauses[i];
+                if (!s.inconsistent() && m_ticks - start < budget && !c.vivified() && !c.frozen() && !c.was_removed() &&
+                    c.glue() <= m_vivify_glue && c.size() > 2) {
+                    s.checkpoint();
+                    m_ticks += c.size();
+                    c.mark_vivified();
+                    if (!vivify(c))
+                        continue;
+                }
+                clauses[j++] = &c;
+            }
+        }
+        catch (solver_exception&) {
+            for (; i < sz; ++i)
+                clauses[j++] = clauses[i];
+            clauses.shrink(j);
+            s.m_phase = saved_phase;
+            m_counter = counter;
+            throw;
+        }
+        clauses.shrink(j);
+        s.m_phase = saved_phase;
+        m_counter = counter;
+        m_vivify_ticks = m_ticks;
+        m_vivified_literals += m_elim_learned_literals - eliml0;
+        if (!s.inconsistent())
+            s.propagate(false);
+        IF_VERBOSE(4, verbose_stream() << "(sat-vivify :learned " << sz << " :elim " << m_elim_learned_literals - eliml0 << " :cost " << m_ticks - start << ")\n";);
+    }
+
+    /**
+       \brief assign the negation of the literals in c one by one.
+       A literal that becomes false is redundant. If a literal becomes true, or
+       a conflict is reached, the literals that remain after it are redundant.
+    */
+    bool asymm_branch::vivify(clause& c) {
+        SASSERT(s.scope_lvl() == 0);
+        for (literal l : c) {
+            if (s.value(l) == l_true) {
+                // the clause may be the reason for l
+                if (!s.can_delete(c))
+                    return true;
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        scoped_detach scoped_d(s, c);
+        unsigned sz = c.size(), new_sz = 0, i = 0;
+        s.push();
+        for (; i < sz; ++i) {
+            literal l = c[i];
+            lbool v = s.value(l);
+            if (v == l_false)
+                continue;
+            std::swap(c[i], c[new_sz++]);
+            if (v == l_true)
+                break;
+            s.assign_scoped(~l);
+            s.propagate_core(false);
+            if (s.inconsistent())
+                break;
+        }
+        s.pop(1);
+        if (new_sz == sz)
+            return true;
+        ++m_vivified_clauses;
+        // the literals after new_sz are redundant, remove the ones false at base level from the rest.
+        return cleanup(scoped_d, c, UINT_MAX, new_sz);
+    }
+
     void asymm_branch::updt_params(params_ref const & _p) {
         sat_asymm_branch_params p(_p);
         m_asymm_branch         = p.asymm_branch();
@@ -478,6 +570,9 @@ namespace sat {
         m_asymm_branch_sampled = p.asymm_branch_sampled();
         m_asymm_branch_limit   = p.asymm_branch_limit();
         m_asymm_branch_all     = p.asymm_branch_all();
+        m_vivify               = p.asymm_branch_vivify();
+        m_vivify_glue          = p.asymm_branch_vivify_glue();
+        m_vivify_effort        = p.asymm_branch_vivify_effort();
         if (m_asymm_branch_limit > UINT_MAX)
             m_asymm_branch_limit = UINT_MAX;
     }
@@ -489,12 +584,18 @@ namespace sat {
     void asymm_branch::collect_statistics(statistics & st) const {
         st.update("sat elim literals", m_elim_literals);
         st.update("sat tr", m_tr);
+        st.update("sat vivify calls", m_vivify_calls);
+        st.update("sat vivified clauses", m_vivified_clauses);
+        st.update("sat vivified literals", m_vivified_literals);
     }
 
     void asymm_branch::reset_statistics() {
         m_elim_literals = 0;
         m_elim_learned_literals = 0;
         m_tr = 0;
+        m_vivify_calls = 0;
+        m_vivified_clauses = 0;
+        m_vivified_literals = 0;
     }
 
 };
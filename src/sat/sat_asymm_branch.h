@@ -33,6 +33,9 @@ namespace sat {
         solver &   s;
         params_ref m_params;
         int64_t    m_counter;
+        uint64_t   m_ticks { 0 };         // cost of all propagations, used as budget for vivification
+        uint64_t   m_vivify_ticks { 0 };  // value of m_ticks after the last vivification
+        bool       m_vivify_pending { false };
         random_gen m_rand;
         unsigned   m_calls;
         unsigned   m_touch_index;
@@ -44,11 +47,17 @@ namespace sat {
         bool       m_asymm_branch_sampled;
         bool       m_asymm_branch_all;
         int64_t    m_asymm_branch_limit;
+        bool       m_vivify;
+        unsigned   m_vivify_glue;
+        unsigned   m_vivify_effort;
 
         // stats
         unsigned   m_elim_literals;
         unsigned   m_elim_learned_literals;
         unsigned   m_tr;
+        unsigned   m_vivify_calls;
+        unsigned   m_vivified_clauses;
+        unsigned   m_vivified_literals;
 
         literal_vector m_pos, m_neg; // literals (complements of literals) in clauses sorted by discovery time (m_left in BIG).
         svector<std::pair<literal, unsigned>> m_pos1, m_neg1;
@@ -90,11 +99,27 @@ namespace sat {
 
         bool propagate_literal(clause const& c, literal l);
 
+        bool vivify(clause& c);
+
     public:
         asymm_branch(solver & s, params_ref const & p);
 
         void operator()(bool force);
 
+        /**
+           \brief strengthen learned clauses with small glue by propagating the negation
+           of their literals. The cost is bounded relative to the cost of search propagation.
+        */
+        void vivify_learned();
+        bool vivify_enabled() const { return m_vivify; }
+
+        /**
+           \brief vivification is requested after garbage collection of learned clauses
+           and run at the next restart to base level.
+        */
+        void request_vivify() { m_vivify_pending = m_vivify; }
+        bool vivify_pending() const { return m_vivify_pending; }
+
         void updt_params(params_ref const & p);
         static void collect_param_descrs(param_descrs & d);
 
@@ -103,7 +128,7 @@ namespace sat {
 
         void init_search() { m_calls = 0; }
 
-        inline void dec(unsigned c) { m_counter -= c; }
+        inline void dec(unsigned c) { m_counter -= c; m_ticks += c; }
     };
 
 };
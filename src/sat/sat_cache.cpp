@@ -0,0 +1,185 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_cache.cpp
+
+Abstract:
+
+    Persist learned clauses, phases and activities across runs on the same problem.
+
+    The cache file is keyed by a hash of the irredundant clauses that does not
+    depend on the order of clauses or of literals within clauses.
+    Learned clauses read from the cache are only added if they are
+    reverse unit propagation (RUP) consequences of the current clauses,
+    so a stale or corrupted cache cannot make the solver unsound.
+
+--*/
+
+#include <fstream>
+#include "util/hash.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    static const unsigned s_cache_magic = 0x5a335343; // Z3SC
+    static const unsigned s_cache_version = 1;
+
+    static unsigned lit_hash(literal l) {
+        return hash_u(l.index() + 1);
+    }
+
+    static uint64_t clause_hash(unsigned sz, literal const* lits) {
+        unsigned h = 0;
+        for (unsigned i = 0; i < sz; ++i)
+            h += lit_hash(lits[i]);
+        return (static_cast<uint64_t>(hash_ull((static_cast<uint64_t>(h) << 32) | sz)) << 32) | hash_u(h ^ sz);
+    }
+
+    uint64_t solver::cache_key() const {
+        uint64_t key = num_vars();
+        for (clause* c : m_clauses)
+            if (!c->was_removed())
+                key += clause_hash(c->size(), c->begin());
+        unsigned l_idx = 0;
+        for (watch_list const& wlist : m_watches) {
+            literal l1 = ~to_literal(l_idx++);
+            for (watched const& w : wlist) {
+                if (!w.is_binary_non_learned_clause())
+                    continue;
+                literal l2 = w.get_literal();
+                if (l1.index() < l2.index()) {
+                    literal lits[2] = { l1, l2 };
+                    key += clause_hash(2, lits);
+                }
+            }
+        }
+        for (unsigned i = 0; i < init_trail_size(); ++i)
+            key += clause_hash(1, &m_trail[i]);
+        return key;
+    }
+
+    void solver::load_cache() {
+        m_cache_key = 0;
+        if (!m_config.m_cache.is_non_empty_string() || m_ext || !at_base_lvl() || inconsistent())
+            return;
+        m_cache_key = cache_key();
+        std::ifstream in(m_config.m_cache.str(), std::ios::binary);
+        if (!in)
+            return;
+        auto read = [&](auto& v) { in.read(reinterpret_cast<char*>(&v), sizeof(v)); return in.good(); };
+        unsigned magic = 0, version = 0, nv = 0, n = 0;
+        uint64_t key = 0;
+        if (!read(magic) || !read(version) || !read(key) || !read(nv))
+            return;
+        if (magic != s_cache_magic || version != s_cache_version || key != m_cache_key || nv != num_vars()) {
+            IF_VERBOSE(2, verbose_stream() << "(sat.cache :miss)\n");
+            return;
+        }
+        for (bool_var v = 0; v < nv; ++v) {
+            unsigned act = 0;
+            char phase = 0;
+            if (!read(act) || !read(phase))
+                return;
+            m_phase[v] = m_best_phase[v] = phase != 0;
+            set_activity(v, act);
+        }
+        if (!read(n))
+            return;
+        unsigned num_added = 0;
+        literal_vector lits;
+        for (unsigned i = 0; i < n && !inconsistent(); ++i) {
+            unsigned sz = 0;
+            if (!read(sz) || sz > num_vars())
+                return;
+            lits.reset();
+            bool ok = true;
+            for (unsigned j = 0; j < sz; ++j) {
+                unsigned idx = 0;
+                if (!read(idx))
+                    return;
+                literal l = to_literal(idx);
+                ok &= l.var() < num_vars() && !was_eliminated(l.var());
+                lits.push_back(l);
+            }
+            if (!ok)
+                continue;
+            // check that the clause follows by unit propagation
+            bool is_rup = false;
+            push();
+            for (literal l : lits) {
+                lbool v = value(l);
+                if (v == l_true) {
+                    is_rup = true;
+                    break;
+                }
+                if (v == l_false)
+                    continue;
+                assign_scoped(~l);
+                propagate_core(false);
+                if (inconsistent()) {
+                    is_rup = true;
+                    break;
+                }
+            }
+            pop(1);
+            if (!is_rup)
+                continue;
+            mk_clause(lits, sat::status::redundant());
+            if (!inconsistent())
+                propagate(false);
+            ++num_added;
+        }
+        m_stats.m_cache_clauses += num_added;
+        IF_VERBOSE(2, verbose_stream() << "(sat.cache :hit :clauses " << num_added << " :stored " << n << ")\n");
+    }
+
+    void solver::save_cache() {
+        if (m_cache_key == 0 || !m_config.m_cache.is_non_empty_string())
+            return;
+        std::ofstream out(m_config.m_cache.str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+            return;
+        auto write = [&](auto const& v) { out.write(reinterpret_cast<char const*>(&v), sizeof(v)); };
+        unsigned nv = num_vars();
+        write(s_cache_magic);
+        write(s_cache_version);
+        write(m_cache_key);
+        write(nv);
+        for (bool_var v = 0; v < nv; ++v) {
+            write(m_activity[v]);
+            char phase = m_phase[v] ? 1 : 0;
+            write(phase);
+        }
+        unsigned max_size = m_config.m_cache_max_size;
+        unsigned max_clauses = m_config.m_cache_max_clauses;
+        vector<literal_vector> clauses;
+        unsigned l_idx = 0;
+        for (watch_list const& wlist : m_watches) {
+            literal l1 = ~to_literal(l_idx++);
+            for (watched const& w : wlist) {
+                literal l2;
+                if (w.is_binary_learned_clause() && l1.index() < (l2 = w.get_literal()).index() && clauses.size() < max_clauses) {
+                    clauses.push_back(literal_vector());
+                    clauses.back().push_back(l1);
+                    clauses.back().push_back(l2);
+                }
+            }
+        }
+        for (clause* c : m_learned)
+            if (!c->was_removed() && c->size() <= max_size && clauses.size() < max_clauses)
+                clauses.push_back(literal_vector(c->size(), c->begin()));
+        unsigned n = clauses.size();
+        write(n);
+        for (auto const& lits : clauses) {
+            unsigned sz = lits.size();
+            write(sz);
+            for (literal l : lits) {
+                unsigned idx = l.index();
+                write(idx);
+            }
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat.cache :save :clauses " << n << ")\n");
+    }
+}
@@ -83,7 +83,13 @@ namespace sat {
         m_restart_max     = p.restart_max();
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
+        m_inprocess_schedule = p.inprocess_schedule();
+        m_inprocess_ratio = p.inprocess_ratio();
+        m_inprocess_backoff = p.inprocess_backoff();
         m_inprocess_out   = p.inprocess_out();
+        m_cache           = p.cache();
+        m_cache_max_size  = p.cache_max_size();
+        m_cache_max_clauses = p.cache_max_clauses();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -96,6 +102,9 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_max_size    = p.par_max_size();
+        m_par_max_glue    = p.par_max_glue();
+        m_par_import_budget = p.par_import_budget();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -105,13 +105,22 @@ namespace sat {
         double             m_fast_glue_avg;
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
+        bool               m_inprocess_schedule;
+        double             m_inprocess_ratio;
+        unsigned           m_inprocess_backoff;
         symbol             m_inprocess_out;
+        symbol             m_cache;
+        unsigned           m_cache_max_size;
+        unsigned           m_cache_max_clauses;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_max_size;
+        unsigned           m_par_max_glue;
+        unsigned           m_par_import_budget;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -69,6 +69,7 @@ namespace sat {
             break;
         }
         if (m_ext) m_ext->gc();
+        m_asymm_branch.request_vivify();
         if (gc > 0 && should_defrag()) {
             defrag_clauses();
         }
@@ -0,0 +1,134 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.cpp
+
+Abstract:
+
+    Scheduler for inprocessing techniques.
+
+--*/
+
+#include <algorithm>
+#include "util/symbol.h"
+#include "sat/sat_inprocess.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    char const* inprocess::name(technique t) {
+        switch (t) {
+        case ELIM: return "elim";
+        case ELIM_LEARNED: return "elim-learned";
+        case PROBING: return "probing";
+        case ASYMM_BRANCH: return "asymm-branch";
+        case LOOKAHEAD: return "lookahead";
+        case ANF: return "anf";
+        case CUT: return "cut";
+        default: UNREACHABLE(); return "";
+        }
+    }
+
+    size_t inprocess::problem_size() const {
+        return s.m_clauses.size() + s.m_learned.size() + s.num_vars() - s.m_trail.size();
+    }
+
+    uint64_t inprocess::ticks() const {
+        return static_cast<uint64_t>(s.m_stats.m_propagate) + s.m_stats.m_bin_propagate + s.m_simplifier.ticks();
+    }
+
+    /**
+       \brief charge the ticks since the last inprocessing step to search.
+       The solver statistics may have been reset in between.
+    */
+    void inprocess::sync_search_ticks() {
+        uint64_t t = ticks();
+        m_search_ticks += t >= m_last_ticks ? t - m_last_ticks : t;
+        m_last_ticks = t;
+    }
+
+    void inprocess::schedule(svector<technique> const& candidates, bool reorder, svector<technique>& result) {
+        result.reset();
+        sync_search_ticks();
+        if (!s.m_config.m_inprocess_schedule) {
+            result.append(candidates);
+            return;
+        }
+        for (technique t : candidates) {
+            info& i = m_info[t];
+            if (i.m_skip > 0) {
+                --i.m_skip;
+                ++i.m_skips;
+                continue;
+            }
+            result.push_back(t);
+        }
+        if (reorder)
+            std::stable_sort(result.begin(), result.end(), [&](technique a, technique b) { return m_info[a].rate() > m_info[b].rate(); });
+        double budget = s.m_config.m_inprocess_ratio * m_search_ticks;
+        if (m_total_ticks > budget && result.size() > 1) {
+            IF_VERBOSE(3, verbose_stream() << "(sat.inprocess :over-budget " << m_total_ticks << " :keep " << name(result[0]) << ")\n");
+            for (unsigned j = 1; j < result.size(); ++j)
+                ++m_info[result[j]].m_skips;
+            result.shrink(1);
+        }
+    }
+
+    void inprocess::start(technique t) {
+        SASSERT(m_current == NUM_TECHNIQUES);
+        m_current = t;
+        m_size = problem_size();
+        sync_search_ticks();
+        m_start_ticks = m_last_ticks;
+    }
+
+    void inprocess::stop() {
+        SASSERT(m_current != NUM_TECHNIQUES);
+        info& i = m_info[m_current];
+        m_last_ticks = ticks();
+        // techniques that do not propagate through the solver, such as lookahead,
+        // anf and cut, are charged at least one tick per clause.
+        uint64_t t = m_last_ticks >= m_start_ticks ? m_last_ticks - m_start_ticks : 0;
+        t = std::max<uint64_t>(t, s.m_clauses.size() + s.m_learned.size());
+        size_t sz = problem_size();
+        double yield = m_size > sz ? static_cast<double>(m_size - sz) : 0.0;
+        ++i.m_calls;
+        i.m_ticks += t;
+        i.m_yield += yield;
+        m_total_ticks += t;
+        if (s.m_config.m_inprocess_schedule) {
+            if (yield == 0) {
+                i.m_backoff = std::min(2 * i.m_backoff + 1, s.m_config.m_inprocess_backoff);
+                i.m_skip = i.m_backoff;
+            }
+            else
+                i.m_backoff = 0;
+        }
+        IF_VERBOSE(10, verbose_stream() << "(sat.inprocess " << name(m_current) << " :yield " << yield << " :ticks " << t << " :skip " << i.m_skip << ")\n");
+        m_current = NUM_TECHNIQUES;
+    }
+
+    void inprocess::collect_statistics(statistics& st) const {
+        for (unsigned t = 0; t < NUM_TECHNIQUES; ++t) {
+            info const& i = m_info[t];
+            if (i.m_calls == 0 && i.m_skips == 0)
+                continue;
+            std::string prefix = std::string("sat inprocess ") + name(static_cast<technique>(t));
+            st.update(symbol((prefix + " calls").c_str()).bare_str(), i.m_calls);
+            st.update(symbol((prefix + " skips").c_str()).bare_str(), i.m_skips);
+            st.update(symbol((prefix + " ticks").c_str()).bare_str(), static_cast<double>(i.m_ticks));
+            st.update(symbol((prefix + " yield").c_str()).bare_str(), i.m_yield);
+        }
+    }
+
+    void inprocess::reset_statistics() {
+        for (info& i : m_info) {
+            i.m_calls = 0;
+            i.m_skips = 0;
+            i.m_ticks = 0;
+            i.m_yield = 0;
+        }
+    }
+};
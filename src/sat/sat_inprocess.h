@@ -0,0 +1,95 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.h
+
+Abstract:
+
+    Scheduler for inprocessing techniques.
+
+    Each technique is measured by the ticks it takes and by its yield:
+    the number of clauses it removes and the number of units it finds.
+    Ticks are propagations plus the work charged to the simplifier's
+    subsumption and resolution counters, so schedules are reproducible.
+    When sat.inprocess.schedule is set, techniques are run in order of
+    decreasing yield per tick, a technique without yield is skipped for
+    an exponentially growing number of rounds, and once inprocessing has
+    used more than a configured fraction of the search ticks only the
+    most productive technique of each group of candidates is run.
+    Otherwise all candidates run in their fixed order.
+
+--*/
+#pragma once
+
+#include <cfloat>
+#include <cstdint>
+#include "util/statistics.h"
+#include "util/vector.h"
+
+namespace sat {
+    class solver;
+
+    class inprocess {
+    public:
+        enum technique {
+            ELIM = 0,      // simplifier on irredundant clauses
+            ELIM_LEARNED,  // simplifier on learned clauses
+            PROBING,
+            ASYMM_BRANCH,
+            LOOKAHEAD,
+            ANF,
+            CUT,
+            NUM_TECHNIQUES
+        };
+
+    private:
+        struct info {
+            unsigned m_calls { 0 };
+            unsigned m_skips { 0 };
+            unsigned m_skip { 0 };     // number of rounds to skip
+            unsigned m_backoff { 0 };  // next skip interval
+            uint64_t m_ticks { 0 };
+            double   m_yield { 0 };
+            double rate() const { return m_calls == 0 ? DBL_MAX : m_yield / (m_ticks + 1); }
+        };
+
+        solver&   s;
+        info      m_info[NUM_TECHNIQUES];
+        uint64_t  m_total_ticks { 0 };   // ticks spent inprocessing
+        uint64_t  m_search_ticks { 0 };  // ticks spent outside inprocessing
+        uint64_t  m_last_ticks { 0 };
+        technique m_current { NUM_TECHNIQUES };
+        size_t    m_size { 0 };
+        uint64_t  m_start_ticks { 0 };
+
+        size_t problem_size() const;
+        uint64_t ticks() const;
+        void sync_search_ticks();
+
+    public:
+        inprocess(solver& s): s(s) {}
+
+        /**
+           \brief select the techniques among candidates to run in this round.
+           If reorder is set, the result is ordered by decreasing yield rate.
+        */
+        void schedule(svector<technique> const& candidates, bool reorder, svector<technique>& result);
+
+        void start(technique t);
+        void stop();
+
+        class scope {
+            inprocess& p;
+        public:
+            scope(inprocess& p, technique t): p(p) { p.start(t); }
+            ~scope() { p.stop(); }
+        };
+
+        static char const* name(technique t);
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics();
+    };
+};
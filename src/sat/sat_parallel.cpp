@@ -22,66 +22,68 @@ Revision History:
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        index = (n >= m_size) ? 0 : n;
+    parallel::clause_ring::clause_ring(unsigned sz): 
+        m_data(alloc_vect<std::atomic<unsigned>>(sz)), 
+        m_size(sz) {
     }
 
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
-    }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
-            }
-            m_at_end[i] = false;
-        }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
+    parallel::clause_ring::~clause_ring() {
+        dealloc_vect(m_data, m_size);
     }
 
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
+    bool parallel::clause_ring::push(unsigned n, literal const* lits) {
+        if (n + 2 > capacity())
+            return false;
+        uint64_t tail = m_published.load(std::memory_order_relaxed);
+        // announce the region about to be overwritten before touching it.
+        m_reserved.store(tail + n + 2, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        set(tail, n);
+        set(tail + 1, m_seq++);
+        for (unsigned i = 0; i < n; ++i)
+            set(tail + 2 + i, lits[i].index());
+        m_published.store(tail + n + 2, std::memory_order_release);
+        return true;
     }
 
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) 
-            m_tail = 0;
+    /**
+       \brief read the clause at position head.
+       Return l_undef if there are no new clauses, l_false if the clause was overwritten
+       while or before it was read, and l_true if the clause was read into lits.
+       In the first two cases head is moved to the most recently published position.
+       The sequence number of the clause is stored in seq.
+     */
+    lbool parallel::clause_ring::read(uint64_t& head, unsigned& seq, literal_vector& lits) const {
+        uint64_t tail = m_published.load(std::memory_order_acquire);
+        if (head == tail)
+            return l_undef;
+        if (tail - head > capacity()) {
+            head = tail;
+            return l_false;
+        }
+        unsigned n = get(head);
+        seq = get(head + 1);
+        lits.reset();
+        bool fits = static_cast<uint64_t>(n) + 2 <= tail - head;
+        for (unsigned i = 0; fits && i < n; ++i)
+            lits.push_back(to_literal(get(head + 2 + i)));
+        // the values read are valid only if the producer did not start overwriting them.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!fits || m_reserved.load(std::memory_order_relaxed) - head > capacity()) {
+            head = tail;
+            return l_false;
+        }
+        head += n + 2;
+        return l_true;
     }
 
-
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
-                return true;
-            }
-            head = m_heads[owner];
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_rings.reset();
+        m_workers.reset();
+        for (unsigned i = 0; i < num_owners; ++i) {
+            m_rings.push_back(alloc(clause_ring, sz));
+            m_workers.push_back(alloc(worker, num_owners));
         }
-        return false;
     }
 
     parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
@@ -146,58 +148,80 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        m_rings[s.m_par_id]->push(2, lits);
+        m_workers[s.m_par_id]->m_exported++;
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
-        if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
+        if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
+        worker& w = *m_workers[s.m_par_id];
+        if (!enable_add(s, c)) {
+            w.m_filtered++;
+            return;
+        }
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
-        unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) 
-            m_pool.add_vector_elem(c[i].index());
-        m_pool.end_add_vector();        
+        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  c << "\n";);
+        if (m_rings[s.m_par_id]->push(c.size(), c.begin()))
+            w.m_exported++;
+        else
+            w.m_filtered++;
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
         _get_clauses(s);        
     }
 
     void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
-            }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
-            if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+        unsigned budget = s.get_config().m_par_import_budget;
+        worker& w = *m_workers[owner];
+        for (unsigned i = 0; i < m_rings.size(); ++i) {
+            if (i == owner)
+                continue;
+            clause_ring const& ring = *m_rings[i];
+            unsigned seq = 0;
+            lbool r = l_true;
+            for (unsigned j = 0; j < budget && r != l_undef; ++j) {
+                r = ring.read(w.m_heads[i], seq, w.m_lits);
+                if (r != l_true)
+                    continue;
+                // clauses skipped since the last read were overwritten.
+                w.m_dropped += seq - w.m_seqs[i];
+                w.m_seqs[i] = seq + 1;
+                bool usable_clause = true;
+                for (literal lit : w.m_lits)
+                    usable_clause &= lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
+                IF_VERBOSE(3, verbose_stream() << owner << ": retrieve " << w.m_lits << "\n";);
+                SASSERT(w.m_lits.size() >= 2);
+                if (usable_clause) {
+                    s.mk_clause_core(w.m_lits.size(), w.m_lits.data(), sat::status::redundant());
+                    w.m_imported++;
+                }
             }
-        }        
+        }
     }
 
-    bool parallel::enable_add(clause const& c) const {
+    bool parallel::enable_add(solver& s, clause const& c) const {
         // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        config const& cfg = s.get_config();
+        return (c.size() <= cfg.m_par_max_size && c.glue() <= cfg.m_par_max_glue) || c.glue() <= 2;
+    }
+
+    void parallel::collect_statistics(statistics& st) const {
+        unsigned exported = 0, filtered = 0, imported = 0, dropped = 0;
+        for (worker const* w : m_workers) {
+            exported += w->m_exported;
+            filtered += w->m_filtered;
+            imported += w->m_imported;
+            dropped += w->m_dropped;
+        }
+        st.update("sat par exported", exported);
+        st.update("sat par filtered", filtered);
+        st.update("sat par imported", imported);
+        st.update("sat par dropped", dropped);
     }
 
     void parallel::_from_solver(solver& s) {
@@ -24,31 +24,48 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include "util/statistics.h"
+#include <atomic>
 
 namespace sat {
 
     class parallel {
 
-        // shared pool of learned clauses.
-        class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+        // Bounded single-producer, multi-consumer ring of learned clauses.
+        // Each thread publishes its learned clauses into its own ring and
+        // never waits for readers: when the ring is full the oldest clauses
+        // are overwritten. Readers keep their own position and detect
+        // clauses that were overwritten before they got to read them.
+        // A clause is stored as its size, a sequence number, and its literals.
+        class clause_ring {
+            std::atomic<unsigned>* m_data;
+            unsigned               m_size;
+            unsigned               m_seq { 0 };
+            std::atomic<uint64_t>  m_reserved { 0 };   // end of the region the producer may be writing into
+            std::atomic<uint64_t>  m_published { 0 };  // end of the region readable by consumers
+            unsigned capacity() const { return m_size; }
+            unsigned get(uint64_t index) const { return m_data[index % m_size].load(std::memory_order_relaxed); }
+            void set(uint64_t index, unsigned e) { m_data[index % m_size].store(e, std::memory_order_relaxed); }
         public:
-            void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            clause_ring(unsigned sz);
+            ~clause_ring();
+            bool push(unsigned n, literal const* lits);
+            lbool read(uint64_t& head, unsigned& seq, literal_vector& lits) const;
         };
 
-        bool enable_add(clause const& c) const;
+        // state owned by a single thread.
+        struct worker {
+            svector<uint64_t> m_heads;   // read position in the rings of other threads.
+            unsigned_vector   m_seqs;    // expected sequence number in the rings of other threads.
+            literal_vector    m_lits;
+            unsigned          m_exported { 0 };
+            unsigned          m_filtered { 0 };
+            unsigned          m_imported { 0 };
+            unsigned          m_dropped { 0 };
+            worker(unsigned num_workers): m_heads(num_workers, static_cast<uint64_t>(0)), m_seqs(num_workers, 0u) {}
+        };
+
+        bool enable_add(solver& s, clause const& c) const;
         void _get_clauses(solver& s);
         void _from_solver(solver& s);
         void _to_solver(solver& s);
@@ -58,8 +75,8 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
+        scoped_ptr_vector<clause_ring> m_rings;
+        scoped_ptr_vector<worker>      m_workers;
         mutex          m_mux;
 
         // for exchange with local search:
@@ -84,8 +101,8 @@ namespace sat {
 
         void push_child(reslimit& rl);
 
-        // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        // reserve space for clauses shared by each owner
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -110,6 +127,8 @@ namespace sat {
         void to_solver(i_local_search& s);
         
         bool copy_solver(solver& s);
+
+        void collect_statistics(statistics& st) const;
     };
 
 };
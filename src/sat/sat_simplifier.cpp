@@ -24,6 +24,10 @@ Revision History:
 #include "sat/sat_integrity_checker.h"
 #include "util/stopwatch.h"
 #include "util/trace.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace sat {
 
@@ -217,6 +221,10 @@ namespace sat {
 
         m_sub_counter  = m_subsumption_limit;
         m_elim_counter = m_res_limit;
+        on_scope_exit _ticks([&]() {
+            m_ticks += std::max<int64_t>(0, static_cast<int64_t>(m_subsumption_limit) - m_sub_counter);
+            m_ticks += std::max<int64_t>(0, static_cast<int64_t>(m_res_limit) - m_elim_counter);
+        });
         m_old_num_elim_vars = m_num_elim_vars;
 
         for (bool_var v = 0; v < s.num_vars(); ++v) {
@@ -1803,9 +1811,13 @@ namespace sat {
        Return false if the result is a tautology
     */
     bool simplifier::resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r) {
+        return resolve(c1, c2, l, r, m_visited, m_elim_counter);
+    }
+
+    bool simplifier::resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r, svector<char>& visited, int& counter) const {
         CTRACE(resolve_bug, !c1.contains(l) || !c2.contains(~l), tout << c1 << "\n" << c2 << "\nl: " << l << "\n";);
-        if (m_visited.size() <= 2*s.num_vars())
-            m_visited.resize(2*s.num_vars(), false);
+        if (visited.size() <= 2*s.num_vars())
+            visited.resize(2*s.num_vars(), false);
         if (c1.was_removed() && !c1.contains(l))
             return false;
         if (c2.was_removed() && !c2.contains(~l))
@@ -1813,13 +1825,13 @@ namespace sat {
         SASSERT(c1.contains(l));
         SASSERT(c2.contains(~l));
         bool res = true;
-        m_elim_counter -= c1.size() + c2.size();
+        counter -= c1.size() + c2.size();
         unsigned sz1 = c1.size();
         for (unsigned i = 0; i < sz1; ++i) {
             literal l1 = c1[i];
             if (l == l1)
                 continue;
-            m_visited[l1.index()] = true;
+            visited[l1.index()] = true;
             r.push_back(l1);
         }
 
@@ -1829,21 +1841,21 @@ namespace sat {
             literal l2 = c2[i];
             if (not_l == l2)
                 continue;
-            if ((~l2).index() >= m_visited.size()) {
-                //s.display(std::cout << l2 << " " << s.num_vars() << " " << m_visited.size() << "\n");
+            if ((~l2).index() >= visited.size()) {
+                //s.display(std::cout << l2 << " " << s.num_vars() << " " << visited.size() << "\n");
                 UNREACHABLE();
             }
-            if (m_visited[(~l2).index()]) {
+            if (visited[(~l2).index()]) {
                 res = false;
                 break;
             }
-            if (!m_visited[l2.index()])
+            if (!visited[l2.index()])
                 r.push_back(l2);
         }
 
         for (unsigned i = 0; i < sz1; ++i) {
             literal l1 = c1[i];
-            m_visited[l1.index()] = false;
+            visited[l1.index()] = false;
         }
         return res;
     }
@@ -1909,10 +1921,15 @@ namespace sat {
         }
     }
 
-    bool simplifier::try_eliminate(bool_var v) {
-        if (value(v) != l_undef)
-            return false;
-
+    /**
+       \brief check whether eliminating v by resolution does not increase the number of clauses.
+       The clauses containing v and ~v are collected in pos_cls and neg_cls.
+       Besides compacting the use lists of v and ~v while iterating over them, the
+       function only reads the clause database, so it can be called concurrently for
+       different variables with separate scratch space.
+    */
+    bool simplifier::can_eliminate(bool_var v, clause_wrapper_vector& pos_cls, clause_wrapper_vector& neg_cls, literal_vector& new_cls,
+                                   svector<char>& visited, int& counter, unsigned& cost) {
         literal pos_l(v, false);
         literal neg_l(v, true);
         unsigned num_bin_pos = num_nonlearned_bin(pos_l);
@@ -1950,29 +1967,47 @@ namespace sat {
             s.m_clauses.size() <= m_res_cls_cutoff1)
             return false;
 
-        m_pos_cls.reset();
-        m_neg_cls.reset();
-        collect_clauses(pos_l, m_pos_cls);
-        collect_clauses(neg_l, m_neg_cls);
+        pos_cls.reset();
+        neg_cls.reset();
+        collect_clauses(pos_l, pos_cls);
+        collect_clauses(neg_l, neg_cls);
 
-        TRACE(sat_simplifier, tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
         unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
-                m_new_cls.reset();
-                if (resolve(c1, c2, pos_l, m_new_cls)) {
-                    TRACE(sat_simplifier, tout << c1 << "\n" << c2 << "\n-->\n";
-                          for (literal l : m_new_cls) tout << l << " "; tout << "\n";);
+        for (clause_wrapper& c1 : pos_cls) {
+            for (clause_wrapper& c2 : neg_cls) {
+                new_cls.reset();
+                if (resolve(c1, c2, pos_l, new_cls, visited, counter)) {
                     after_clauses++;
-                    if (after_clauses > before_clauses) {
-                        TRACE(sat_simplifier, tout << "too many after clauses: " << after_clauses << "\n";);
+                    if (after_clauses > before_clauses) 
                         return false;
-                    }
                 }
             }
         }
-        TRACE(sat_simplifier, tout << "eliminate " << v << ", before: " << before_clauses << " after: " << after_clauses << "\n";
+        cost = num_pos * num_neg + before_lits;
+        return true;
+    }
+
+    bool simplifier::try_eliminate(bool_var v) {
+        if (value(v) != l_undef)
+            return false;
+
+        unsigned cost = 0;
+        TRACE(sat_simplifier, tout << "collecting number of after_clauses\n";);
+        if (!can_eliminate(v, m_pos_cls, m_neg_cls, m_new_cls, m_visited, m_elim_counter, cost))
+            return false;
+        eliminate(v, cost);
+        return true;
+    }
+
+    /**
+       \brief eliminate v by resolution. m_pos_cls and m_neg_cls contain the clauses
+       with v and ~v collected by can_eliminate.
+    */
+    void simplifier::eliminate(bool_var v, unsigned cost) {
+        literal pos_l(v, false);
+        literal neg_l(v, true);
+        TRACE(sat_simplifier, tout << "eliminate " << v << "\n";
               tout << "pos\n";
               for (auto & c : m_pos_cls) 
                   tout << c << "\n";
@@ -1980,9 +2015,9 @@ namespace sat {
               for (auto & c : m_neg_cls) 
                   tout << c << "\n";
               );
-        m_elim_counter -= num_pos * num_neg + before_lits;
+        m_elim_counter -= cost;
 
-        m_elim_counter -= num_pos * num_neg + before_lits;
+        m_elim_counter -= cost;
 
         // eliminate variable
         ++s.m_stats.m_elim_var_res;
@@ -1991,7 +2026,7 @@ namespace sat {
         save_clauses(mc_entry, m_pos_cls);
         save_clauses(mc_entry, m_neg_cls);
         s.set_eliminated(v, true);
-        m_elim_counter -= num_pos * num_neg + before_lits;
+        m_elim_counter -= cost;
 
         for (auto & c1 : m_pos_cls) {
             if (c1.was_removed() && !c1.contains(pos_l))
@@ -2034,7 +2069,7 @@ namespace sat {
                     break;
                 }
                 if (s.inconsistent())
-                    return true;
+                    return;
             }
         }
         remove_bin_clauses(pos_l);
@@ -2047,7 +2082,6 @@ namespace sat {
             pos_occs.reset();
             neg_occs.reset();
         }
-        return true;
     }
 
     struct simplifier::elim_var_report {
@@ -2077,6 +2111,15 @@ namespace sat {
         elim_var_report rpt(*this);
         bool_var_vector vars;
         order_vars_for_elim(vars);
+#ifndef SINGLE_THREAD
+        if (m_elim_vars_threads > 1) {
+            elim_vars_par(vars);
+            m_pos_cls.finalize();
+            m_neg_cls.finalize();
+            m_new_cls.finalize();
+            return;
+        }
+#endif
         for (bool_var v : vars) {
             checkpoint();
             if (m_elim_counter < 0) 
@@ -2092,6 +2135,142 @@ namespace sat {
         m_new_cls.finalize();
     }
 
+#ifndef SINGLE_THREAD
+    /**
+       \brief eliminate variables in rounds. Each round selects, in elimination order,
+       a batch of variables whose clauses share no variables with the clauses of other
+       variables in the batch. Whether elimination is profitable is checked for the
+       variables of the batch concurrently, then the profitable variables are eliminated
+       sequentially in elimination order. Eliminating a variable of the batch does not
+       change the clauses of the other variables, except by unit propagation, so the
+       result does not depend on the number of threads. The clauses and cost computed
+       by the concurrent check are reused unless units were propagated since the check.
+    */
+    void simplifier::elim_vars_par(bool_var_vector const& vars) {
+        unsigned num_threads = m_elim_vars_threads;
+        unsigned const max_batch = 1 << 14;
+        unsigned const max_rounds = 16;
+        struct scratch {
+            clause_wrapper_vector m_pos, m_neg;
+            literal_vector        m_new;
+            svector<char>         m_visited;
+            int                   m_counter = 0;
+        };
+        scoped_ptr_vector<scratch> scratches;
+        for (unsigned i = 0; i < num_threads; ++i)
+            scratches.push_back(alloc(scratch));
+        svector<char> marked(s.num_vars(), static_cast<char>(0));
+        bool_var_vector todo(vars), batch, deferred, touched;
+        svector<char> profitable;
+        vector<clause_wrapper_vector> pos_cls, neg_cls;
+        unsigned_vector costs;
+        auto is_candidate = [&](bool_var v) {
+            return !is_external(v) && !was_eliminated(v) && value(v) == l_undef;
+        };
+        // collect the variables that occur in irredundant clauses with v
+        auto collect_neighbors = [&](bool_var v, bool_var_vector& r) {
+            r.reset();
+            r.push_back(v);
+            for (literal l : { literal(v, false), literal(v, true) }) {
+                for (auto it = m_use_list.get(l).mk_iterator(); !it.at_end(); it.next())
+                    if (!it.curr().is_learned())
+                        for (literal l2 : it.curr())
+                            r.push_back(l2.var());
+                for (watched const& w : get_wlist(~l))
+                    if (w.is_binary_non_learned_clause())
+                        r.push_back(w.get_literal().var());
+            }
+        };
+        bool_var_vector neighbors;
+        for (unsigned round = 0; !todo.empty() && round < max_rounds; ++round) {
+            if (m_elim_counter < 0 || s.inconsistent())
+                return;
+            checkpoint();
+            batch.reset();
+            deferred.reset();
+            touched.reset();
+            for (bool_var v : todo) {
+                if (!is_candidate(v))
+                    continue;
+                if (batch.size() >= max_batch) {
+                    deferred.push_back(v);
+                    continue;
+                }
+                collect_neighbors(v, neighbors);
+                if (any_of(neighbors, [&](bool_var w) { return marked[w] != 0; })) {
+                    deferred.push_back(v);
+                    continue;
+                }
+                for (bool_var w : neighbors) {
+                    marked[w] = 1;
+                    touched.push_back(w);
+                }
+                batch.push_back(v);
+            }
+            for (bool_var w : touched)
+                marked[w] = 0;
+
+            profitable.reset();
+            profitable.resize(batch.size(), static_cast<char>(0));
+            pos_cls.reset();
+            neg_cls.reset();
+            pos_cls.resize(batch.size());
+            neg_cls.resize(batch.size());
+            costs.reset();
+            costs.resize(batch.size(), 0);
+            auto check = [&](unsigned id) {
+                scratch& sc = *scratches[id];
+                for (unsigned i = id; i < batch.size(); i += num_threads) {
+                    profitable[i] = can_eliminate(batch[i], sc.m_pos, sc.m_neg, sc.m_new, sc.m_visited, sc.m_counter, costs[i]);
+                    if (profitable[i]) {
+                        pos_cls[i].swap(sc.m_pos);
+                        neg_cls[i].swap(sc.m_neg);
+                    }
+                }
+            };
+            unsigned trail_sz = s.m_trail.size();
+            vector<std::thread> threads;
+            for (unsigned id = 1; id < num_threads; ++id)
+                threads.push_back(std::thread([&, id]() { check(id); }));
+            check(0);
+            for (auto& th : threads)
+                th.join();
+            for (scratch* sc : scratches) {
+                m_elim_counter += sc->m_counter;
+                sc->m_counter = 0;
+            }
+            IF_VERBOSE(10, verbose_stream() << "(sat-resolution :batch " << batch.size() << " :deferred " << deferred.size() << ")\n";);
+
+            for (unsigned i = 0; i < batch.size(); ++i) {
+                if (!profitable[i])
+                    continue;
+                checkpoint();
+                if (m_elim_counter < 0 || s.inconsistent())
+                    return;
+                if (s.m_trail.size() != trail_sz) {
+                    // units may have removed or strengthened the clauses of batch[i].
+                    if (try_eliminate(batch[i]))
+                        m_num_elim_vars++;
+                    continue;
+                }
+                m_pos_cls.swap(pos_cls[i]);
+                m_neg_cls.swap(neg_cls[i]);
+                eliminate(batch[i], costs[i]);
+                m_num_elim_vars++;
+            }
+            todo.swap(deferred);
+        }
+        // remaining variables have too many dependencies to be batched.
+        for (bool_var v : todo) {
+            checkpoint();
+            if (m_elim_counter < 0 || s.inconsistent())
+                return;
+            if (is_candidate(v) && try_eliminate(v))
+                m_num_elim_vars++;
+        }
+    }
+#endif
+
     void simplifier::updt_params(params_ref const & _p) {
         sat_simplifier_params p(_p);
         m_cce                     = p.cce();
@@ -2117,6 +2296,7 @@ namespace sat {
         m_subsumption             = p.subsumption();
         m_subsumption_limit       = p.subsumption_limit();
         m_elim_vars               = p.elim_vars();
+        m_elim_vars_threads       = p.elim_vars_threads();
         m_incremental_mode        = s.get_config().m_incremental && !p.override_incremental();
     }
 
@@ -75,6 +75,7 @@ namespace sat {
         // counters
         int                    m_sub_counter;
         int                    m_elim_counter;
+        uint64_t               m_ticks { 0 }; // work charged to the counters over all calls
 
         // config
         bool                   m_abce; // block clauses using asymmetric added literals
@@ -103,6 +104,7 @@ namespace sat {
         bool                   m_subsumption;
         unsigned               m_subsumption_limit;
         bool                   m_elim_vars;
+        unsigned               m_elim_vars_threads;
         bool                   m_elim_vars_bdd;
         unsigned               m_elim_vars_bdd_delay;
 
@@ -199,12 +201,17 @@ namespace sat {
         clause_wrapper_vector m_neg_cls;
         literal_vector m_new_cls;
         bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r);
+        bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r, svector<char>& visited, int& counter) const;
+        bool can_eliminate(bool_var v, clause_wrapper_vector& pos_cls, clause_wrapper_vector& neg_cls, literal_vector& new_cls,
+                           svector<char>& visited, int& counter, unsigned& cost);
         void save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs);
         void add_non_learned_binary_clause(literal l1, literal l2);
         void remove_bin_clauses(literal l);
         void remove_clauses(clause_use_list const & cs, literal l);
         bool try_eliminate(bool_var v);
+        void eliminate(bool_var v, unsigned cost);
         void elim_vars();
+        void elim_vars_par(bool_var_vector const& vars);
 
         struct blocked_cls_report;
         struct subsumption_report;
@@ -249,6 +256,8 @@ namespace sat {
 
         bool need_cleanup() const { return m_need_cleanup; }
 
+        uint64_t ticks() const { return m_ticks; }
+
     };
 };
 
@@ -40,6 +40,15 @@ Revision History:
 
 namespace sat {
 
+    static inline void prefetch(void const* p) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p);
+#else
+    #if !defined(_M_ARM) && !defined(_M_ARM64)
+        _mm_prefetch((const char*)p, _MM_HINT_T1);
+    #endif
+#endif
+    }
 
     solver::solver(params_ref const & p, reslimit& l):
         solver_core(l),
@@ -53,6 +62,7 @@ namespace sat {
         m_scc(*this, p),
         m_asymm_branch(*this, p),
         m_probing(*this, p),
+        m_inprocess(*this),
         m_mus(*this),
         m_inconsistent(false),
         m_searching(false),
@@ -919,15 +929,8 @@ namespace sat {
             }
         }
         
-        if (m_config.m_propagate_prefetch) {
-#if defined(__GNUC__) || defined(__clang__)
-            __builtin_prefetch((const char*)((m_watches[l.index()].data())));
-#else
-    #if !defined(_M_ARM) && !defined(_M_ARM64)
-            _mm_prefetch((const char*)((m_watches[l.index()].data())), _MM_HINT_T1);
-    #endif
-#endif
-        }
+        if (m_config.m_propagate_prefetch) 
+            prefetch(m_watches[l.index()].data());
 
         SASSERT(!l.sign() || !m_phase[v]);
         SASSERT(l.sign()  || m_phase[v]);
@@ -1026,12 +1029,17 @@ namespace sat {
         watch_list::iterator it = wlist.begin();
         watch_list::iterator it2 = it;
         watch_list::iterator end = wlist.end();
+        bool prefetch_clauses = m_config.m_propagate_prefetch;
 #define CONFLICT_CLEANUP() {                    \
                 for (; it != end; ++it, ++it2)  \
                     *it2 = *it;                 \
                 wlist.set_end(it2);             \
             }
         for (; it != end; ++it) {
+            // fetch the clause of the next watch while processing the current one,
+            // unless the blocked literal already satisfies it.
+            if (prefetch_clauses && it + 1 != end && it[1].is_clause() && value(it[1].get_blocked_literal()) != l_true)
+                prefetch(&get_clause(it[1].get_clause_offset()));
             switch (it->get_kind()) {
             case watched::BINARY:
                 l1 = it->get_literal();
@@ -1263,6 +1271,8 @@ namespace sat {
             if (check_inconsistent()) return l_false;
             propagate(false);
             if (check_inconsistent()) return l_false;
+            load_cache();
+            if (check_inconsistent()) return l_false;
             init_assumptions(num_lits, lits);
             propagate(false);
             if (check_inconsistent()) return l_false;
@@ -1297,8 +1307,10 @@ namespace sat {
                 m_restart_threshold = m_config.m_burst_search;
                 lbool r = bounded_search();
                 log_stats();
-                if (r != l_undef) 
+                if (r != l_undef) {
+                    save_cache();
                     return r;
+                }
                 
                 pop_reinit(scope_lvl());
                 m_conflicts_since_restart = 0;
@@ -1307,6 +1319,7 @@ namespace sat {
 
             lbool is_sat = search();
             log_stats();
+            save_cache();
             return is_sat;
         }
         catch (const abort_solver &) {
@@ -1498,7 +1511,7 @@ namespace sat {
 #define IS_MAIN_SOLVER(i)  (i == main_solver_offset)
 
         sat::parallel par(*this);
-        par.reserve(num_threads, 1 << 12);
+        par.reserve(num_threads, 1 << 14);
         par.init_solvers(*this, num_extra_solvers);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
@@ -1597,6 +1610,7 @@ namespace sat {
         if (!canceled) {
             rlimit().reset_cancel();
         }
+        par.collect_statistics(m_aux_stats);
         par.reset();
         set_par(nullptr, 0);
         ls.reset();
@@ -2050,16 +2064,16 @@ namespace sat {
         if (m_ext) {
             m_ext->pre_simplify();
         }
-      
-        m_simplifier(false);
 
-        CASSERT("sat_simplify_bug", check_invariant());
-        CASSERT("sat_missed_prop", check_missed_propagation());
-        if (!m_learned.empty()) {
-            m_simplifier(true);
-            CASSERT("sat_missed_prop", check_missed_propagation());
-            CASSERT("sat_simplify_bug", check_invariant());
-        }
+        // variable elimination runs before the extension is notified of modified clauses.
+        svector<inprocess::technique> candidates, techniques;
+        candidates.push_back(inprocess::ELIM);
+        if (!m_learned.empty())
+            candidates.push_back(inprocess::ELIM_LEARNED);
+        m_inprocess.schedule(candidates, false, techniques);
+        for (auto t : techniques)
+            inprocess_core(t);
+
         sort_watch_lits();
         CASSERT("sat_simplify_bug", check_invariant());
 
@@ -2070,15 +2084,16 @@ namespace sat {
             m_ext->simplify();
         }
 
-        m_probing();
-        CASSERT("sat_missed_prop", check_missed_propagation());
-        CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
-
-        if (m_config.m_lookahead_simplify && !m_ext) {
-            lookahead lh(*this);
-            lh.simplify(true);
-            lh.collect_statistics(m_aux_stats);
+        candidates.reset();
+        candidates.push_back(inprocess::PROBING);
+        candidates.push_back(inprocess::ASYMM_BRANCH);
+        if (m_config.m_lookahead_simplify && !m_ext)
+            candidates.push_back(inprocess::LOOKAHEAD);
+        m_inprocess.schedule(candidates, true, techniques);
+        for (auto t : techniques) {
+            if (inconsistent())
+                break;
+            inprocess_core(t);
         }
 
         reinit_assumptions();
@@ -2098,17 +2113,17 @@ namespace sat {
             m_par->to_solver(*this);
         }
 
-        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent()) {
-            anf_simplifier anf(*this);
-            anf_simplifier::config cfg;
-            cfg.m_enable_exlin = m_config.m_anf_exlin;
-            anf();
-            anf.collect_statistics(m_aux_stats);
-            // TBD: throttle anf_delay based on yield
-        }
-        
-        if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent()) {
-            (*m_cut_simplifier)();
+        // anf and cut simplification run after the exchange with the parallel solvers.
+        candidates.reset();
+        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay)
+            candidates.push_back(inprocess::ANF);
+        if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay)
+            candidates.push_back(inprocess::CUT);
+        m_inprocess.schedule(candidates, true, techniques);
+        for (auto t : techniques) {
+            if (inconsistent())
+                break;
+            inprocess_core(t);
         }
 
         if (m_config.m_inprocess_out.is_non_empty_string()) {
@@ -2120,6 +2135,44 @@ namespace sat {
         }
     }
 
+    void solver::inprocess_core(inprocess::technique t) {
+        inprocess::scope _scope(m_inprocess, t);
+        switch (t) {
+        case inprocess::ELIM:
+            m_simplifier(false);
+            break;
+        case inprocess::ELIM_LEARNED:
+            m_simplifier(true);
+            break;
+        case inprocess::PROBING:
+            m_probing();
+            break;
+        case inprocess::ASYMM_BRANCH:
+            m_asymm_branch(false);
+            break;
+        case inprocess::LOOKAHEAD: {
+            lookahead lh(*this);
+            lh.simplify(true);
+            lh.collect_statistics(m_aux_stats);
+            break;
+        }
+        case inprocess::ANF: {
+            anf_simplifier anf(*this);
+            anf();
+            anf.collect_statistics(m_aux_stats);
+            break;
+        }
+        case inprocess::CUT:
+            (*m_cut_simplifier)();
+            break;
+        default:
+            UNREACHABLE();
+            break;
+        }
+        CASSERT("sat_missed_prop", check_missed_propagation());
+        CASSERT("sat_simplify_bug", check_invariant());
+    }
+
     bool solver::set_root(literal l, literal r) {
         return !m_ext || m_ext->set_root(l, r);
     }
@@ -2353,6 +2406,10 @@ namespace sat {
         IF_VERBOSE(30, display_status(verbose_stream()););
         TRACE(sat, tout << "restart " << restart_level(to_base) << "\n";);
         pop_reinit(restart_level(to_base));
+        // vivification requested by gc runs at base level, which a restart
+        // only reaches when there are no assumptions.
+        if (m_asymm_branch.vivify_pending() && scope_lvl() == 0 && !inconsistent())
+            m_asymm_branch.vivify_learned();
         set_next_restart();        
     }
 
@@ -3786,6 +3843,7 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_inprocess.collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
@@ -3798,6 +3856,7 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        m_inprocess.reset_statistics();
         m_aux_stats.reset();
     }
 
@@ -4769,6 +4828,7 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat cache clauses", m_cache_clauses);
     }
 
     void stats::reset() {
@@ -41,6 +41,7 @@ Revision History:
 #include "sat/sat_asymm_branch.h"
 #include "sat/sat_cut_simplifier.h"
 #include "sat/sat_probing.h"
+#include "sat/sat_inprocess.h"
 #include "sat/sat_mus.h"
 #include "sat/sat_drat.h"
 #include "sat/sat_parallel.h"
@@ -78,6 +79,7 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_cache_clauses;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -111,6 +113,7 @@ namespace sat {
         scc                     m_scc;
         asymm_branch            m_asymm_branch;
         probing                 m_probing;
+        inprocess               m_inprocess;
         bool                    m_is_probing { false };
         mus                     m_mus;           // MUS for minimal core extraction
         bool                    m_inconsistent;
@@ -237,6 +240,7 @@ namespace sat {
         friend class lut_finder;
         friend class npn3_finder;
         friend class proof_trim;
+        friend class inprocess;
         friend struct backoff;
     public:
         solver(params_ref const & p, reslimit& l);
@@ -575,6 +579,7 @@ namespace sat {
         bool is_assumption(literal l) const;
         bool should_simplify() const;
         void do_simplify();
+        void inprocess_core(inprocess::technique t);
         void mk_model();
         bool check_model(model const & m) const;
         void do_restart(bool to_base);
@@ -599,6 +604,16 @@ namespace sat {
         lbool do_unit_walk();
         struct scoped_ls; 
 
+        // -----------------------
+        //
+        // Cache of learned clauses, phases and activities across runs
+        //
+        // -----------------------
+        uint64_t m_cache_key { 0 };
+        uint64_t cache_key() const;
+        void load_cache();
+        void save_cache();
+
         // -----------------------
         //
         // GC
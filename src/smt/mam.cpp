@@ -17,8 +17,13 @@ Revision History:
 
 --*/
 #include <algorithm>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 #include "util/pool.h"
+#include "util/mutex.h"
+#include "util/scoped_ptr_vector.h"
 #include "util/trail.h"
 #include "util/stopwatch.h"
 #include "ast/ast_pp.h"
@@ -542,6 +547,23 @@ namespace {
             return m_candidates;
         }
 
+        /**
+           \brief Remove duplicates and candidates that are not congruence roots,
+           as the interpreter does on the fly for trees that filter candidates.
+        */
+        void remove_duplicate_candidates() {
+            unsigned j = 0;
+            for (enode* app : m_candidates) {
+                if (!app->is_marked() && app->is_cgr()) {
+                    app->set_mark();
+                    m_candidates[j++] = app;
+                }
+            }
+            m_candidates.shrink(j);
+            for (enode* app : m_candidates)
+                app->unset_mark();
+        }
+
 #ifdef Z3DEBUG
         void set_context(context * ctx) {
             SASSERT(m_context == 0);
@@ -1833,6 +1855,33 @@ namespace {
 
     typedef svector<backtrack_point> backtrack_stack;
 
+    /**
+       \brief Matches found by an interpreter that runs concurrently with other
+       interpreters. They are passed to the context after matching.
+    */
+    struct match_buffer {
+        struct entry {
+            quantifier * m_qa;
+            app *        m_pat;
+            unsigned     m_num_bindings;
+            unsigned     m_bindings_idx;
+            unsigned     m_max_generation;
+            unsigned     m_min_top_generation;
+            unsigned     m_max_top_generation;
+            unsigned     m_used_enodes_idx;
+            unsigned     m_num_used_enodes;
+        };
+        svector<entry>                       m_entries;
+        enode_vector                         m_bindings;
+        vector<std::tuple<enode *, enode *>> m_used_enodes;
+
+        void reset() {
+            m_entries.reset();
+            m_bindings.reset();
+            m_used_enodes.reset();
+        }
+    };
+
     class interpreter {
         context &           m_context;
         ast_manager &       m;
@@ -1855,6 +1904,11 @@ namespace {
         enode *             m_app;
         const bind *        m_b;
 
+        // set when the interpreter runs concurrently with other interpreters:
+        // matches are recorded in m_buffer and shared state of the context is accessed under m_lock.
+        match_buffer *      m_buffer { nullptr };
+        mutex *             m_lock { nullptr };
+
         // equalities used for pattern match. The first element of the tuple gives the argument (or null) of some term that was matched against some higher level
         // structure of the trigger, the second element gives the term that argument is replaced with in order to match the trigger. Used for logging purposes only.
         vector<std::tuple<enode *, enode *>> m_used_enodes;
@@ -1970,6 +2024,37 @@ namespace {
             } }
         }
 
+        enode * get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args) {
+            if (m_lock) {
+                lock_guard lock(*m_lock);
+                return m_context.get_enode_eq_to(f, num_args, args);
+            }
+            return m_context.get_enode_eq_to(f, num_args, args);
+        }
+
+        bool resource_limits_exceeded() {
+            if (m_lock) {
+                lock_guard lock(*m_lock);
+                return m.limit().is_canceled();
+            }
+            return m_context.resource_limits_exceeded();
+        }
+
+        void buffer_match(quantifier * qa, app * pat, unsigned num_bindings) {
+            match_buffer::entry e;
+            e.m_qa               = qa;
+            e.m_pat              = pat;
+            e.m_num_bindings     = num_bindings;
+            e.m_bindings_idx     = m_buffer->m_bindings.size();
+            e.m_max_generation   = m_max_generation;
+            get_min_max_top_generation(e.m_min_top_generation, e.m_max_top_generation);
+            e.m_used_enodes_idx  = m_buffer->m_used_enodes.size();
+            e.m_num_used_enodes  = m_used_enodes.size();
+            m_buffer->m_bindings.append(num_bindings, m_bindings.data());
+            m_buffer->m_used_enodes.append(m_used_enodes);
+            m_buffer->m_entries.push_back(e);
+        }
+
         enode_vector * mk_depth1_vector(enode * n, func_decl * f, unsigned i);
 
         enode_vector * mk_depth2_vector(joint2 * j2, func_decl * f, unsigned i);
@@ -1995,6 +2080,14 @@ namespace {
             m_args.resize(INIT_ARGS_SIZE);
         }
 
+        void set_lock(mutex * lock) {
+            m_lock = lock;
+        }
+
+        void set_buffer(match_buffer * b) {
+            m_buffer = b;
+        }
+
         void init(code_tree * t) {
             TRACE(mam_bug, tout << "preparing to match tree:\n" << *t << "\n";);
             m_registers.reserve(t->get_num_regs(), nullptr);
@@ -2007,11 +2100,12 @@ namespace {
             TRACE(trigger_bug, tout << "execute for code tree:\n"; t->display(tout););
             init(t);
 #define CLEANUP  for (enode* app : t->get_candidates()) if (app->is_marked()) app->unset_mark();
-            if (t->filter_candidates()) {
+            // concurrent interpreters do not mark candidates, the filter is applied before matching
+            if (t->filter_candidates() && !m_buffer) {
                 for (enode* app : t->get_candidates()) {
                     TRACE(trigger_bug, tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
                     if (!app->is_marked() && app->is_cgr()) {
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app)) {
+                        if (resource_limits_exceeded() || !execute_core(t, app)) {
                             CLEANUP;
                             return false;
                         }
@@ -2027,7 +2121,7 @@ namespace {
                     if (app->is_cgr()) {
                         TRACE(trigger_bug, tout << "is_cgr\n";);
                         // scoped_suspend_rlimit susp(m.limit(), false);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (resource_limits_exceeded() || !execute_core(t, app))
                             return false;
                     }
                 }
@@ -2534,6 +2628,10 @@ namespace {
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                   \
             m_max_generation = std::max(m_max_generation, get_max_generation(NUM, m_bindings.begin())); \
+            if (m_buffer) {                                             \
+                buffer_match(static_cast<const yield *>(m_pc)->m_qa, static_cast<const yield *>(m_pc)->m_pat, NUM); \
+                goto backtrack;                                         \
+            }                                                           \
             if (m_context.get_cancel_flag()) {                          \
                 return false;                                           \
             }                                                           \
@@ -2599,7 +2697,7 @@ namespace {
 
         case GET_CGR1:
 #define GET_CGR_COMMON()                                                                                                                                                \
-            m_n1 = m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
+            m_n1 = get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
                 goto backtrack;                                                                                                                                         \
             update_max_generation(m_n1, nullptr);                                                                                                                       \
@@ -2710,7 +2808,7 @@ namespace {
 
         if (since_last_check++ > 100) {
             since_last_check = 0;
-            if (m_context.resource_limits_exceeded()) {
+            if (resource_limits_exceeded()) {
                 // Soft timeout...
                 // Cleanup before exiting
                 while (m_top != 0) {
@@ -3128,6 +3226,13 @@ namespace {
         enode *                     m_r1; // temp field
         enode *                     m_r2; // temp field
 
+        // concurrent matching of code trees, see match_trees_parallel
+        scoped_ptr_vector<interpreter> m_workers;
+        vector<match_buffer>        m_buffers;      // matches of m_to_match[i]
+        mutex                       m_lock;
+        vector<stopwatch>           m_thread_watch; // matching time of each thread
+        unsigned                    m_num_parallel_rounds { 0 };
+
         class add_shared_enode_trail;
         friend class add_shared_enode_trail;
 
@@ -3887,17 +3992,129 @@ namespace {
 
         void match() override {
             TRACE(trigger_bug, tout << "match\n"; display(tout););
+            if (!match_trees())
+                return;
+            m_to_match.reset();
+            if (!m_new_patterns.empty()) {
+                match_new_patterns();
+                m_new_patterns.reset();
+            }
+        }
+
+        bool match_trees() {
+#ifndef SINGLE_THREAD
+            unsigned num_threads = std::min(m_context.get_fparams().m_qi_ematching_threads, m_to_match.size());
+            if (num_threads > 1)
+                return match_trees_parallel(std::min(num_threads, s_max_ematching_threads));
+#endif
             for (code_tree* t : m_to_match) {
                 SASSERT(t->has_candidates());
                 if (!m_interpreter.execute(t))
-                    return;
+                    return false;
                 t->reset_candidates();
             }
-            m_to_match.reset();
-            if (!m_new_patterns.empty()) {
-                match_new_patterns();
-                m_new_patterns.reset();
+            return true;
+        }
+
+#ifndef SINGLE_THREAD
+        static constexpr unsigned s_max_ematching_threads = 16;
+
+        /**
+           \brief Match the code trees of m_to_match concurrently.
+
+           The e-graph is not modified during matching: instances are only queued by the context.
+           Each thread runs its own interpreter against the e-graph and records the matches of
+           each code tree in m_buffers. The matches are then passed to the context in the order
+           of m_to_match, so the same instances are queued in the same order as by match_trees.
+        */
+        bool match_trees_parallel(unsigned num_threads) {
+            unsigned num_trees = m_to_match.size();
+            while (m_workers.size() < num_threads) {
+                m_workers.push_back(alloc(interpreter, m_context, *this, m_use_filters));
+                m_workers.back()->set_lock(&m_lock);
+            }
+            m_thread_watch.reserve(num_threads, stopwatch());
+            m_buffers.reserve(num_trees);
+            for (unsigned i = 0; i < num_trees; ++i) {
+                m_buffers[i].reset();
+                if (m_to_match[i]->filter_candidates())
+                    m_to_match[i]->remove_duplicate_candidates();
+            }
+            ++m_num_parallel_rounds;
+
+            std::atomic<unsigned> next(0);
+            std::atomic<unsigned> failed(num_trees); // first tree that could not be matched completely
+            bool has_ex = false;
+            std::string ex_msg;
+            auto worker = [&](unsigned id) {
+                scoped_watch _sw(m_thread_watch[id]);
+                interpreter & intp = *m_workers[id];
+                try {
+                    unsigned i;
+                    while ((i = next++) < num_trees && i < failed) {
+                        intp.set_buffer(&m_buffers[i]);
+                        if (!intp.execute(m_to_match[i])) {
+                            unsigned f = failed;
+                            while (i < f && !failed.compare_exchange_weak(f, i))
+                                ;
+                        }
+                    }
+                }
+                catch (z3_exception & ex) {
+                    lock_guard lock(m_lock);
+                    has_ex = true;
+                    ex_msg = ex.what();
+                    failed = 0;
+                }
+                intp.set_buffer(nullptr);
+            };
+            vector<std::thread> threads(num_threads - 1);
+            for (unsigned i = 1; i < num_threads; ++i)
+                threads[i - 1] = std::thread([&, i]() { worker(i); });
+            worker(0);
+            for (auto & th : threads)
+                th.join();
+            if (has_ex)
+                throw default_exception(std::move(ex_msg));
+
+            // trees before the failed tree were matched completely, the failed tree partially.
+            unsigned f = failed;
+            for (unsigned i = 0; i < num_trees && i <= f; ++i) {
+                add_buffered_matches(m_buffers[i]);
+                if (i < f)
+                    m_to_match[i]->reset_candidates();
+            }
+            if (f < num_trees) {
+                m_context.resource_limits_exceeded();
+                return false;
             }
+            return true;
+        }
+#endif
+
+        void add_buffered_matches(match_buffer & b) {
+            vector<std::tuple<enode *, enode *>> used_enodes;
+            for (auto const& e : b.m_entries) {
+                used_enodes.reset();
+                for (unsigned k = 0; k < e.m_num_used_enodes; ++k)
+                    used_enodes.push_back(b.m_used_enodes[e.m_used_enodes_idx + k]);
+                m_context.add_instance(e.m_qa, e.m_pat, e.m_num_bindings, b.m_bindings.data() + e.m_bindings_idx, nullptr,
+                                       e.m_max_generation, e.m_min_top_generation, e.m_max_top_generation, used_enodes);
+            }
+            b.reset();
+        }
+
+        void collect_statistics(::statistics & st) const override {
+            static char const* thread_time_keys[] = {
+                "ematching-thread-0-time", "ematching-thread-1-time", "ematching-thread-2-time", "ematching-thread-3-time",
+                "ematching-thread-4-time", "ematching-thread-5-time", "ematching-thread-6-time", "ematching-thread-7-time",
+                "ematching-thread-8-time", "ematching-thread-9-time", "ematching-thread-10-time", "ematching-thread-11-time",
+                "ematching-thread-12-time", "ematching-thread-13-time", "ematching-thread-14-time", "ematching-thread-15-time" };
+            if (m_num_parallel_rounds == 0)
+                return;
+            st.update("ematching-parallel-rounds", m_num_parallel_rounds);
+            for (unsigned i = 0; i < m_thread_watch.size() && i < std::size(thread_time_keys); ++i)
+                st.update(thread_time_keys[i], m_thread_watch[i].get_seconds());
         }
 
         void rematch(bool use_irrelevant) override {
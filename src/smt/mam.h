@@ -20,6 +20,7 @@ Revision History:
 
 #include "ast/ast.h"
 #include "smt/smt_types.h"
+#include "util/statistics.h"
 #include <tuple>
 
 namespace smt {
@@ -63,6 +64,8 @@ namespace smt {
         
         virtual bool is_shared(enode * n) const = 0;
 
+        virtual void collect_statistics(::statistics & st) const {}
+
 #ifdef Z3DEBUG
         virtual bool check_missing_instances() = 0;
 #endif
@@ -17,12 +17,14 @@ Revision History:
 
 --*/
 #include "util/warning.h"
+#include "util/stopwatch.h"
 #include "util/stats.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/rewriter/var_subst.h"
 #include "smt/smt_context.h"
 #include "smt/qi_queue.h"
+#include <cmath>
 #include <iostream>
 
 namespace smt {
@@ -133,9 +135,51 @@ namespace smt {
         return std::max(generation + 1, static_cast<unsigned>(r));
     }
 
+    /**
+       \brief Scores are bumped by an increment that grows with every conflict, as in VSIDS,
+       so older conflicts count less. The increment grows by 1/decay for each conflict since
+       the last bump, including conflicts that did not use any instance.
+    */
+    void qi_queue::bump_conflict_score(q::quantifier_stat * stat, unsigned conflict) {
+        if (conflict != m_last_conflict) {
+            // the conflict counter restarts with each check
+            unsigned gap = m_last_conflict < conflict ? conflict - m_last_conflict : 1;
+            m_last_conflict = conflict;
+            double f = std::pow(m_params.m_qi_throttle_decay, static_cast<double>(gap));
+            if (m_conflict_score_inc > 1e100 * f) {
+                // decay the scores instead of growing the increment past 1e100
+                double s = f / m_conflict_score_inc;
+                for (quantifier * q : m_qm)
+                    m_qm.get_stat(q)->scale_conflict_score(s);
+                m_max_conflict_score *= s;
+                m_conflict_score_inc = 1.0;
+            }
+            else
+                m_conflict_score_inc /= f;
+        }
+        stat->add_conflict_score(m_conflict_score_inc);
+        m_max_conflict_score = std::max(m_max_conflict_score, stat->get_conflict_score());
+    }
+
+    // quantifiers are throttled only after they had a chance to produce conflicts
+    static const unsigned s_throttle_min_instances = 100;
+
+    float qi_queue::get_throttle_penalty(q::quantifier_stat * stat) const {
+        if (m_max_conflict_score == 0 || stat->get_num_instances() < s_throttle_min_instances)
+            return 0.0f;
+        double rel = stat->get_conflict_score() / m_max_conflict_score;
+        return static_cast<float>(m_params.m_qi_throttle_penalty * (1.0 - rel));
+    }
+
     void qi_queue::insert(fingerprint * f, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         quantifier * q         = static_cast<quantifier*>(f->get_data());
         float cost             = get_cost(q, pat, generation, min_top_generation, max_top_generation);
+        if (m_params.m_qi_throttle) {
+            float penalty = get_throttle_penalty(m_qm.get_stat(q));
+            if (cost <= m_eager_cost_threshold && cost + penalty > m_eager_cost_threshold)
+                m_stats.m_num_throttled++;
+            cost += penalty;
+        }
         TRACE(qi_queue_detail,
               tout << "new instance of " << q->get_qid() << ", weight " << q->get_weight()
               << ", generation: " << generation << ", scope_level: " << m_context.get_scope_level() << ", cost: " << cost << "\n";
@@ -197,6 +241,35 @@ namespace smt {
     }
 
     void qi_queue::instantiate(entry & ent) {
+        if (!m_params.m_qi_profile) {
+            instantiate_core(ent);
+            return;
+        }
+        scoped_watch _sw(m_qm.get_stat(static_cast<quantifier*>(ent.m_qb->get_data()))->instantiate_watch());
+        instantiate_core(ent);
+    }
+
+    // a quantifier is reported as a matching loop when most of its instances have a high generation
+    // and hardly any of them was used in a conflict.
+    static const unsigned s_loop_min_instances = 1000;
+    static const unsigned s_loop_min_bucket    = 5; // generation 8 and above
+
+    void qi_queue::check_matching_loop(quantifier * q, q::quantifier_stat * stat) {
+        unsigned num_instances = stat->get_num_instances();
+        if (stat->is_matching_loop() || num_instances < s_loop_min_instances || num_instances % 256 != 0)
+            return;
+        unsigned high = 0;
+        for (unsigned b = s_loop_min_bucket; b < q::quantifier_stat::num_generation_buckets(); ++b)
+            high += stat->get_generation_count(b);
+        if (2 * high < num_instances || 100 * stat->get_num_conflicts() >= num_instances)
+            return;
+        stat->set_matching_loop();
+        m_stats.m_num_matching_loops++;
+        IF_VERBOSE(1, verbose_stream() << "(smt.qi :matching-loop " << q->get_qid() << " :instances " << num_instances
+                   << " :conflicts " << stat->get_num_conflicts() << " :max-generation " << stat->get_max_generation() << ")\n";);
+    }
+
+    void qi_queue::instantiate_core(entry & ent) {
         // set temporary flag to enable quantifier-specific tracing in within smt_internalizer.
         flet<bool> _coming_from_quant(m_context.m_coming_from_quant, true);
 
@@ -260,6 +333,9 @@ namespace smt {
    
         TRACE(qi_queue, tout << "simplified instance:\n" << s_instance << "\n";);
         stat->inc_num_instances();
+        stat->inc_generation(generation);
+        if (m_params.m_qi_profile)
+            check_matching_loop(q, stat);
         if (stat->get_num_instances() % m_params.m_qi_profile_freq == 0) {
             m_qm.display_stats(verbose_stream(), q);
         }
@@ -503,6 +579,10 @@ namespace smt {
     void qi_queue::collect_statistics(::statistics & st) const {
         st.update("quant instantiations", m_stats.m_num_instances);
         st.update("lazy quant instantiations", m_stats.m_num_lazy_instances);
+        if (m_stats.m_num_matching_loops > 0)
+            st.update("quant matching loops", m_stats.m_num_matching_loops);
+        if (m_params.m_qi_throttle)
+            st.update("quant throttled instances", m_stats.m_num_throttled);
         st.update("missed quant instantiations", m_delayed_entries.size());
         float min, max;
         get_min_max_costs(min, max);
@@ -33,7 +33,7 @@ namespace smt {
     class context;
 
     struct qi_queue_stats {
-        unsigned m_num_instances, m_num_lazy_instances;
+        unsigned m_num_instances, m_num_lazy_instances, m_num_matching_loops, m_num_throttled;
         void reset() { memset(this, 0, sizeof(qi_queue_stats)); }
         qi_queue_stats() { reset(); }
     };
@@ -52,6 +52,10 @@ namespace smt {
         cached_var_subst              m_subst;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold = 0;
+        // conflict scores of quantifiers for qi.throttle
+        double                        m_conflict_score_inc = 1.0;
+        double                        m_max_conflict_score = 0.0;
+        unsigned                      m_last_conflict = UINT_MAX;
         struct entry {
             fingerprint * m_qb;
             float         m_cost;
@@ -75,6 +79,9 @@ namespace smt {
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
         void instantiate(entry & ent);
+        void instantiate_core(entry & ent);
+        void check_matching_loop(quantifier * q, q::quantifier_stat * stat);
+        float get_throttle_penalty(q::quantifier_stat * stat) const;
         void get_min_max_costs(float & min, float & max) const;
         void display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation);
 
@@ -87,6 +94,10 @@ namespace smt {
         */
         void insert(fingerprint * f, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
         void instantiate();
+        /**
+           \brief Invoked when an instance of a quantifier with the given stat is used in the conflict with index conflict.
+        */
+        void bump_conflict_score(q::quantifier_stat * stat, unsigned conflict);
         bool has_work() const { return !m_new_entries.empty(); }
         void init_search_eh();
         bool final_check_eh();
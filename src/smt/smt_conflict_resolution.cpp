@@ -313,6 +313,12 @@ namespace smt {
         bool_var var = antecedent.var();
         unsigned lvl = m_ctx.get_assign_level(var);
         SASSERT(var < m_ctx.get_num_bool_vars());
+        if (m_params.m_qi_profile || m_params.m_qi_throttle) {
+            // the literal (not q) of an instance of q is removed from its clause when q is true at the
+            // base level, q is then an antecedent of the justification of the clause.
+            literal l = ~antecedent;
+            m_ctx.qi_conflict_clause_eh(1, &l);
+        }
         TRACE(conflict_, tout << "processing antecedent (level " << lvl << "):";
               m_ctx.display_literal(tout, antecedent);
               m_ctx.display_detailed_literal(tout << " ", antecedent) << "\n";);
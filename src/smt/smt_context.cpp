@@ -44,6 +44,7 @@ Revision History:
 #include "smt/smt_model_finder.h"
 #include "smt/smt_parallel.h"
 #include "smt/smt_arith_value.h"
+#include <fstream>
 #include <iostream>
 
 namespace smt {
@@ -169,12 +170,13 @@ namespace smt {
             if (d.is_theory_atom() && !src_ctx.m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) {
                 continue;
             }
-            expr_ref fml0(src_m), fml1(dst_m);
-            src_ctx.literal2expr(lit, fml0);
-            if (src_m.is_true(fml0))
+            // translate the atom and negate in the destination, so the source manager is not modified.
+            if (lit == true_literal)
                 continue;
-            fml1 = tr(fml0.get());
-            dst_ctx.assert_expr(fml1);
+            expr_ref fml(tr(src_ctx.bool_var2expr(lit.var())), dst_m);
+            if (lit.sign())
+                fml = dst_m.mk_not(fml);
+            dst_ctx.assert_expr(fml);
         }
 
         dst_ctx.setup_context(dst_ctx.m_fparams.m_auto_config);
@@ -3512,6 +3514,13 @@ namespace smt {
               );
         m_search_finalized = true;
         display_profile(verbose_stream());
+        if (!m_fparams.m_qi_profile_file.empty() && !m_is_auxiliary) {
+            std::ofstream out(m_fparams.m_qi_profile_file);
+            if (out)
+                m_qmanager->display_profile_json(out);
+            else
+                warning_msg("could not open file '%s' for the quantifier instantiation profile", m_fparams.m_qi_profile_file.c_str());
+        }
         if (r == l_true && get_cancel_flag()) 
             r = l_undef;
         if (r == l_undef && m_internal_completed == l_true && has_sls_model()) {
@@ -603,6 +603,10 @@ namespace smt {
             return !m_qmanager->empty();
         }
 
+        void qi_conflict_clause_eh(unsigned num_lits, literal const * lits) {
+            m_qmanager->conflict_clause_eh(num_lits, lits);
+        }
+
         /**
            \brief Return true if the logical context internalized or will internalize universal quantifiers.
         */
@@ -17,6 +17,7 @@ Author:
 
 
 #include "util/scoped_ptr_vector.h"
+#include "util/stopwatch.h"
 #include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -36,8 +37,152 @@ namespace smt {
 #else
 
 #include <thread>
+#include <condition_variable>
 
 namespace smt {
+
+    /**
+       \brief tree of cubes shared by the work-stealing scheduler.
+
+       Each node extends the cube of its parent by one literal. Open leaves
+       are waiting for a worker, active leaves are being solved by their owner.
+       A busy worker splits its cube when other workers are idle, keeping one
+       half and leaving the other half open to be stolen. A refuted cube closes
+       the subtree rooted at the shortest prefix of the cube that occurs in
+       the unsat core. The problem is unsat when the root is closed.
+
+       The tree is not synchronized, callers hold the scheduler lock.
+    */
+    class cube_tree {
+        enum state { open_s, active_s, split_s, closed_s };
+        struct node {
+            unsigned m_parent;
+            unsigned m_depth;
+            state    m_state = open_s;
+            unsigned m_owner = UINT_MAX;
+            unsigned m_effort = 0;       // conflicts spent on the node and its ancestors
+            unsigned m_children[2] = { UINT_MAX, UINT_MAX };
+            node(unsigned parent, unsigned depth): m_parent(parent), m_depth(depth) {}
+        };
+        ast_manager&     m;
+        vector<node>     m_nodes;
+        expr_ref_vector  m_lits;         // literal added by each node, null for the root
+        unsigned_vector  m_open;
+
+        unsigned mk_node(unsigned parent, expr* lit, unsigned effort) {
+            unsigned id = m_nodes.size();
+            m_nodes.push_back(node(parent, parent == UINT_MAX ? 0 : m_nodes[parent].m_depth + 1));
+            m_nodes[id].m_effort = effort;
+            m_lits.push_back(lit);
+            m_open.push_back(id);
+            return id;
+        }
+
+        void close_subtree(unsigned id, unsigned self, unsigned_vector& cancel) {
+            unsigned_vector todo;
+            todo.push_back(id);
+            while (!todo.empty()) {
+                node& n = m_nodes[todo.back()];
+                todo.pop_back();
+                if (n.m_state == active_s && n.m_owner != self)
+                    cancel.push_back(n.m_owner);
+                if (n.m_state == split_s) {
+                    todo.push_back(n.m_children[0]);
+                    todo.push_back(n.m_children[1]);
+                }
+                n.m_state = closed_s;
+            }
+            unsigned j = 0;
+            for (unsigned n : m_open)
+                if (m_nodes[n].m_state == open_s)
+                    m_open[j++] = n;
+            m_open.shrink(j);
+        }
+
+    public:
+        cube_tree(ast_manager& m): m(m), m_lits(m) {
+            mk_node(UINT_MAX, nullptr, 0);
+        }
+
+        bool is_closed(unsigned id) const { return m_nodes[id].m_state == closed_s; }
+
+        bool is_unsat() const { return is_closed(0); }
+
+        unsigned num_open() const { return m_open.size(); }
+
+        /**
+           \brief claim the open cube with the most effort spent on its ancestors.
+           Return UINT_MAX if there is no open cube.
+        */
+        unsigned claim(unsigned worker) {
+            if (m_open.empty())
+                return UINT_MAX;
+            unsigned best = 0;
+            for (unsigned i = 1; i < m_open.size(); ++i)
+                if (m_nodes[m_open[i]].m_effort > m_nodes[m_open[best]].m_effort)
+                    best = i;
+            unsigned id = m_open[best];
+            m_open[best] = m_open.back();
+            m_open.pop_back();
+            m_nodes[id].m_state = active_s;
+            m_nodes[id].m_owner = worker;
+            return id;
+        }
+
+        void get_cube(unsigned id, expr_ref_vector& cube) const {
+            cube.reset();
+            for (; id != 0; id = m_nodes[id].m_parent)
+                cube.push_back(m_lits.get(id));
+            cube.reverse();
+        }
+
+        void add_effort(unsigned id, unsigned effort) {
+            m_nodes[id].m_effort += effort;
+        }
+
+        /**
+           \brief split the active cube id on lit.
+           The owner continues with the positive half, the negative half is left open.
+        */
+        unsigned split(unsigned id, expr* lit) {
+            node& n = m_nodes[id];
+            SASSERT(n.m_state == active_s);
+            unsigned owner = n.m_owner, effort = n.m_effort;
+            n.m_state = split_s;
+            expr_ref neg(m.mk_not(lit), m);
+            unsigned pos_id = mk_node(id, lit, effort);
+            unsigned neg_id = mk_node(id, neg, effort);
+            m_nodes[id].m_children[0] = pos_id;
+            m_nodes[id].m_children[1] = neg_id;
+            m_open.pop_back();
+            m_open.pop_back();
+            m_open.push_back(neg_id);
+            m_nodes[pos_id].m_state = active_s;
+            m_nodes[pos_id].m_owner = owner;
+            return pos_id;
+        }
+
+        /**
+           \brief close the ancestor of id whose cube has the given depth.
+           Closing propagates to parents whose children are both closed.
+           Owners of active cubes that became closed are added to cancel.
+        */
+        void close(unsigned id, unsigned depth, unsigned_vector& cancel) {
+            SASSERT(depth <= m_nodes[id].m_depth);
+            unsigned self = m_nodes[id].m_owner;
+            while (m_nodes[id].m_depth > depth)
+                id = m_nodes[id].m_parent;
+            close_subtree(id, self, cancel);
+            while (id != 0) {
+                id = m_nodes[id].m_parent;
+                node const& n = m_nodes[id];
+                if (!is_closed(n.m_children[0]) || !is_closed(n.m_children[1]))
+                    break;
+                m_nodes[id].m_state = closed_s;
+            }
+        }
+    };
+
     
     lbool parallel::operator()(expr_ref_vector const& asms) {
 
@@ -73,6 +218,7 @@ namespace smt {
         unsigned error_code = 0;
         bool done = false;
         unsigned num_rounds = 0;
+        std::mutex mux;
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
@@ -84,14 +230,50 @@ namespace smt {
             ast_manager* new_m = alloc(ast_manager, m, true);
             pms.push_back(new_m);
             pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
-            context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
-            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
-            pasms.push_back(tr(asms));
+            pctxs.back()->m_is_auxiliary = true;
+            pasms.push_back(expr_ref_vector(*new_m));
             sl.push_child(&(new_m->limit()));
         }
 
+        // The worker contexts are populated concurrently from the main context,
+        // whose manager is shared read-only for the duration of the copy.
+        {
+            ctx.pop_to_base_lvl();
+            m.set_read_only(true);
+            vector<std::thread> threads(num_threads);
+            for (unsigned i = 0; i < num_threads; ++i) {
+                threads[i] = std::thread([&, i]() {
+                    try {
+                        context& new_ctx = *pctxs[i];
+                        context::copy(ctx, new_ctx, true);
+                        new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+                        ast_translation tr(m, *pms[i], false);
+                        pasms[i] = tr(asms);
+                    }
+                    catch (z3_error & err) {
+                        std::lock_guard<std::mutex> lock(mux);
+                        error_code = err.error_code();
+                        ex_kind = ERROR_EX;
+                        done = true;
+                    }
+                    catch (z3_exception & ex) {
+                        std::lock_guard<std::mutex> lock(mux);
+                        ex_msg = ex.what();
+                        ex_kind = DEFAULT_EX;
+                        done = true;
+                    }
+                });
+            }
+            for (auto & th : threads) 
+                th.join();
+            m.set_read_only(false);
+            if (done) {
+                if (ex_kind == ERROR_EX) 
+                    throw z3_error(error_code);
+                throw default_exception(std::move(ex_msg));
+            }
+        }
+
         auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
             lookahead lh(ctx);
             c = lh.choose();
@@ -139,8 +321,6 @@ namespace smt {
             IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
         };
 
-        std::mutex mux;
-
         auto worker_thread = [&](int i) {
             try {
                 context& pctx = *pctxs[i];
@@ -212,22 +392,254 @@ namespace smt {
             }
         };
 
+        cube_tree tree(m);
+        std::condition_variable cv;
+        unsigned num_idle = 0;
+        unsigned total_conflicts = 0;
+        bool tree_unsat = false;
+        expr_ref_vector tree_core(m);
+        obj_hashtable<expr> tree_core_set;
+        unsigned_vector unit_in(num_threads, 0u);
+        vector<stopwatch> busy_watch(num_threads), idle_watch(num_threads);
+        unsigned_vector num_cubes(num_threads, 0u), num_splits(num_threads, 0u);
+
+        // the work-stealing functions below are called with mux held.
+        auto finish = [&](unsigned i, lbool r) {
+            if (done)
+                return;
+            done = true;
+            finished_id = i;
+            result = r;
+            for (unsigned j = 0; j < num_threads; ++j) 
+                if (j != i) 
+                    pms[j]->limit().cancel();
+            cv.notify_all();
+        };
+
+        auto abort_workers = [&]() {
+            if (done)
+                return;
+            done = true;
+            for (ast_manager* pm : pms)
+                pm->limit().cancel();
+            cv.notify_all();
+        };
+
+        // collect the new units of worker i. It only uses the worker's context, so mux is not needed.
+        auto export_units = [&](unsigned i, expr_ref_vector& out) {
+            context& pctx = *pctxs[i];
+            pctx.pop_to_base_lvl();
+            unsigned sz = pctx.assigned_literals().size();
+            for (unsigned j = unit_lim[i]; j < sz; ++j) {
+                literal lit = pctx.assigned_literals()[j];
+                expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
+                if (lit.sign()) e = pctx.m.mk_not(e);
+                out.push_back(e);
+            }
+            unit_lim[i] = sz;
+        };
+
+        // publish the units exported by worker i and take the units it has not seen yet.
+        // The translations use the shared manager, so mux is held.
+        auto exchange_units = [&](unsigned i, expr_ref_vector& out, expr_ref_vector& in) {
+            ast_translation tr_out(*pms[i], m);
+            for (expr* e : out) {
+                expr_ref ce(tr_out(e), m);
+                if (!unit_set.contains(ce)) {
+                    unit_set.insert(ce);
+                    unit_trail.push_back(ce);
+                }
+            }
+            out.reset();
+            ast_translation tr_in(m, *pms[i]);
+            for (unsigned j = unit_in[i]; j < unit_trail.size(); ++j) 
+                in.push_back(tr_in(unit_trail.get(j)));
+            unit_in[i] = unit_trail.size();
+        };
+
+        auto steal_thread = [&](unsigned i) {
+            try {
+                context& pctx = *pctxs[i];
+                ast_manager& pm = *pms[i];
+                expr_ref_vector cube(pm), lasms(pm), units_out(pm), units_in(pm);
+                unsigned id = UINT_MAX;
+                while (true) {
+                    export_units(i, units_out);
+                    {
+                        std::unique_lock<std::mutex> lock(mux);
+                        if (id == UINT_MAX || tree.is_closed(id)) {
+                            idle_watch[i].start();
+                            ++num_idle;
+                            cv.wait(lock, [&]() { return done || (id = tree.claim(i)) != UINT_MAX; });
+                            --num_idle;
+                            idle_watch[i].stop();
+                            if (done) 
+                                return;
+                            ++num_cubes[i];
+                            // the worker may have been canceled when its previous cube was closed.
+                            if (m.limit().is_canceled()) {
+                                finish(i, l_undef);
+                                return;
+                            }
+                            pm.limit().reset_cancel();
+                            expr_ref_vector mcube(m);
+                            tree.get_cube(id, mcube);
+                            ast_translation tr(m, pm);
+                            cube.reset();
+                            for (expr* e : mcube)
+                                cube.push_back(tr(e));
+                            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :cube " << mk_bounded_pp(mk_and(cube), pm, 3) << ")\n");
+                        }
+                        exchange_units(i, units_out, units_in);
+                    }
+                    for (expr* u : units_in)
+                        pctx.assert_expr(u);
+                    units_in.reset();
+                    lasms.reset();
+                    lasms.append(pasms[i]);
+                    lasms.append(cube);
+                    pctx.get_fparams().m_max_conflicts = thread_max_conflicts;
+                    busy_watch[i].start();
+                    lbool r = pctx.check(lasms.size(), lasms.data());
+                    busy_watch[i].stop();
+                    bool do_split = false;
+                    {
+                        std::lock_guard<std::mutex> lock(mux);
+                        if (done)
+                            return;
+                        if (tree.is_closed(id))
+                            continue;
+                        tree.add_effort(id, pctx.m_num_conflicts);
+                        total_conflicts += pctx.m_num_conflicts;
+                        if (r == l_true) {
+                            finish(i, r);
+                            return;
+                        }
+                        if (r == l_false) {
+                            // close the subtree of the shortest prefix of the cube used in the core.
+                            unsigned depth = 0;
+                            ast_translation tr(pm, m);
+                            for (expr* e : pctx.unsat_core()) {
+                                unsigned k = cube.size();
+                                while (k > 0 && cube.get(k - 1) != e)
+                                    --k;
+                                depth = std::max(depth, k);
+                                if (pasms[i].contains(e)) {
+                                    expr* ce = tr(e);
+                                    if (!tree_core_set.contains(ce)) {
+                                        tree_core_set.insert(ce);
+                                        tree_core.push_back(ce);
+                                    }
+                                }
+                            }
+                            if (depth == 0) {
+                                finish(i, r);
+                                return;
+                            }
+                            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :close " << depth << ")\n");
+                            pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                            unsigned_vector cancel;
+                            tree.close(id, depth, cancel);
+                            for (unsigned j : cancel)
+                                pms[j]->limit().cancel();
+                            if (tree.is_unsat()) {
+                                tree_unsat = true;
+                                finish(i, r);
+                                return;
+                            }
+                            id = UINT_MAX;
+                            continue;
+                        }
+                        if (pctx.m_num_conflicts < thread_max_conflicts || total_conflicts >= max_conflicts) {
+                            finish(i, r);
+                            return;
+                        }
+                        do_split = num_idle > tree.num_open();
+                    }
+                    if (!do_split)
+                        continue;
+                    pctx.pop_to_base_lvl();
+                    lookahead lh(pctx);
+                    expr_ref c = lh.choose();
+                    if (!c || cube.contains(c) || cube.contains(mk_not(c)))
+                        continue;
+                    if ((pctx.get_random_value() % 2) == 0) 
+                        c = pm.mk_not(c);
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (done || tree.is_closed(id))
+                        continue;
+                    ast_translation tr(pm, m);
+                    id = tree.split(id, tr(c.get()));
+                    cube.push_back(c);
+                    ++num_splits[i];
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :split " << mk_bounded_pp(c, pm, 3) << ")\n");
+                    cv.notify_one();
+                }
+            }
+            catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!done) {
+                    error_code = err.error_code();
+                    ex_kind = ERROR_EX;
+                    abort_workers();
+                }
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!done) {
+                    ex_msg = ex.what();
+                    ex_kind = DEFAULT_EX;
+                    abort_workers();
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!done) {
+                    ex_msg = "unknown exception";
+                    ex_kind = ERROR_EX;
+                    abort_workers();
+                }
+            }
+        };
+
         // for debugging:  num_threads = 1;
 
-        while (true) {
+        if (ctx.get_fparams().m_threads_work_stealing) {
             vector<std::thread> threads(num_threads);
             for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
+                threads[i] = std::thread([&, i]() { steal_thread(i); });
             }
             for (auto & th : threads) {
                 th.join();
             }
-            if (done) break;
+            unsigned cubes = 0, splits = 0;
+            for (unsigned i = 0; i < num_threads; ++i) {
+                cubes += num_cubes[i];
+                splits += num_splits[i];
+                double busy = busy_watch[i].get_seconds();
+                double total = busy + idle_watch[i].get_seconds();
+                std::string key = "smt parallel worker " + std::to_string(i) + " utilization";
+                ctx.m_aux_stats.update(symbol(key.c_str()).bare_str(), total > 0 ? busy / total : 0.0);
+            }
+            ctx.m_aux_stats.update("smt parallel cubes", cubes);
+            ctx.m_aux_stats.update("smt parallel splits", splits);
+        }
+        else {
+            while (true) {
+                vector<std::thread> threads(num_threads);
+                for (unsigned i = 0; i < num_threads; ++i) {
+                    threads[i] = std::thread([&, i]() { worker_thread(i); });
+                }
+                for (auto & th : threads) {
+                    th.join();
+                }
+                if (done) break;
 
-            collect_units();
-            ++num_rounds;
-            max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
-            thread_max_conflicts *= 2;            
+                collect_units();
+                ++num_rounds;
+                max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
+                thread_max_conflicts *= 2;            
+            }
         }
 
         for (context* c : pctxs) {
@@ -252,8 +664,11 @@ namespace smt {
             break;
         case l_false:
             ctx.m_unsat_core.reset();
-            for (expr* e : pctx.unsat_core()) 
-                ctx.m_unsat_core.push_back(tr(e));
+            if (tree_unsat)
+                ctx.m_unsat_core.append(tree_core);
+            else
+                for (expr* e : pctx.unsat_core()) 
+                    ctx.m_unsat_core.push_back(tr(e));
             break;
         default:
             break;
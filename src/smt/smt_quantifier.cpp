@@ -298,6 +298,7 @@ namespace smt {
             max_generation = std::max(max_generation, get_generation(q));
             
             get_stat(q)->update_max_generation(max_generation);
+            get_stat(q)->inc_num_matches();
             fingerprint * f = m_context.add_fingerprint(q, q->get_id(), num_bindings, bindings, def);
             if (f) {
                 if (is_trace_enabled(TraceTag::causality)) {
@@ -321,6 +322,81 @@ namespace smt {
             return f != nullptr;
         }
 
+        /**
+           \brief Record the quantifiers whose instances are used in the current conflict, for qi.profile and qi.throttle.
+           The clause of an instance of q contains the literal (not q), or q is an antecedent of its justification.
+        */
+        void conflict_clause_eh(unsigned num_lits, literal const * lits) {
+            for (unsigned i = 0; i < num_lits; ++i) {
+                literal l = lits[i];
+                if (!l.sign())
+                    continue;
+                expr * e = m_context.bool_var2expr(l.var());
+                q::quantifier_stat * s = nullptr;
+                if (e && is_quantifier(e) && m_quantifier_stat.find(to_quantifier(e), s)) {
+                    unsigned conflict = m_context.get_num_conflicts();
+                    if (s->inc_num_conflicts(conflict) && m_params.m_qi_throttle)
+                        m_qi_queue.bump_conflict_score(s, conflict);
+                    return;
+                }
+            }
+        }
+
+        void collect_statistics(::statistics & st) const {
+            unsigned num_matches = 0, num_conflicts = 0;
+            double time = 0;
+            for (quantifier * q : m_quantifiers) {
+                q::quantifier_stat * s = get_stat(q);
+                num_matches   += s->get_num_matches();
+                num_conflicts += s->get_num_conflicts();
+                time          += s->get_instantiate_time();
+            }
+            st.update("quant matches", num_matches);
+            if (m_params.m_qi_profile) {
+                st.update("quant instance conflicts", num_conflicts);
+                st.update("quant instantiation time", time);
+            }
+        }
+
+        static void display_json_string(std::ostream & out, char const * s) {
+            out << '"';
+            for (; *s; ++s) {
+                if (*s == '"' || *s == '\\')
+                    out << '\\' << *s;
+                else if (static_cast<unsigned char>(*s) < 0x20)
+                    out << ' ';
+                else
+                    out << *s;
+            }
+            out << '"';
+        }
+
+        void display_profile_json(std::ostream & out) const {
+            out << "{\"quantifiers\": [";
+            bool first = true;
+            for (quantifier * q : m_quantifiers) {
+                q::quantifier_stat * s = get_stat(q);
+                out << (first ? "\n" : ",\n") << "  {\"qid\": ";
+                first = false;
+                display_json_string(out, q->get_qid().str().c_str());
+                out << ", \"weight\": " << q->get_weight()
+                    << ", \"matches\": " << s->get_num_matches()
+                    << ", \"instances\": " << s->get_num_instances()
+                    << ", \"checker_sat\": " << s->get_num_instances_checker_sat()
+                    << ", \"simplify_true\": " << s->get_num_instances_simplify_true()
+                    << ", \"conflicts\": " << s->get_num_conflicts()
+                    << ", \"conflict_score\": " << s->get_conflict_score()
+                    << ", \"max_generation\": " << s->get_max_generation()
+                    << ", \"max_cost\": " << s->get_max_cost()
+                    << ", \"instantiate_time\": " << s->get_instantiate_time()
+                    << ", \"generations\": [";
+                for (unsigned b = 0; b < q::quantifier_stat::num_generation_buckets(); ++b)
+                    out << (b > 0 ? ", " : "") << s->get_generation_count(b);
+                out << "], \"matching_loop\": " << (s->is_matching_loop() ? "true" : "false") << "}";
+            }
+            out << "\n]}\n";
+        }
+
         void init_search_eh() {
             m_num_instances = 0;
             for (quantifier * q : m_quantifiers) {
@@ -559,8 +635,18 @@ namespace smt {
     void quantifier_manager::display(std::ostream & out) const {
     }
 
+    void quantifier_manager::conflict_clause_eh(unsigned num_lits, literal const * lits) {
+        m_imp->conflict_clause_eh(num_lits, lits);
+    }
+
+    void quantifier_manager::display_profile_json(std::ostream & out) const {
+        m_imp->display_profile_json(out);
+    }
+
     void quantifier_manager::collect_statistics(::statistics & st) const {
         m_imp->m_qi_queue.collect_statistics(st);
+        m_imp->collect_statistics(st);
+        m_imp->m_plugin->collect_statistics(st);
     }
 
     void quantifier_manager::reset_statistics() {
@@ -657,6 +743,11 @@ namespace smt {
             m_model_finder->pop_scope(num_scopes);            
         }
 
+        void collect_statistics(::statistics & st) const override {
+            m_mam->collect_statistics(st);
+            m_lazy_mam->collect_statistics(st);
+        }
+
         void init_search_eh() override {
             m_lazy_matching_idx = 0;
             m_model_finder->init_search_eh();
@@ -23,6 +23,7 @@ Revision History:
 #include "util/statistics.h"
 #include "util/params.h"
 #include "smt/smt_types.h"
+#include "smt/smt_literal.h"
 #include <tuple>
 
 class proto_model;
@@ -92,6 +93,12 @@ namespace smt {
 
         void display(std::ostream & out) const;
         void display_stats(std::ostream & out, quantifier * q) const;
+        void display_profile_json(std::ostream & out) const;
+
+        /**
+           \brief Invoked for the clauses used to resolve a conflict when qi.profile or qi.throttle is set.
+        */
+        void conflict_clause_eh(unsigned num_lits, literal const * lits);
 
         void collect_statistics(::statistics & st) const;
         void reset_statistics();
@@ -175,6 +182,8 @@ namespace smt {
         virtual void push() = 0;
         virtual void pop(unsigned num_scopes) = 0;
 
+        virtual void collect_statistics(::statistics & st) const {}
+
 
 
     };
@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include <thread>
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +132,82 @@ static void tst5() {
     m.del(arr3);
 }
 
+#ifndef SINGLE_THREAD
+// terms built concurrently in the same manager are shared.
+static void tst_concurrent() {
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    unsigned num_asts = m.get_num_asts();
+    unsigned num_threads = 4, num_terms = 200;
+    vector<expr_ref_vector> results;
+    for (unsigned i = 0; i < num_threads; ++i)
+        results.push_back(expr_ref_vector(m));
+    m.set_concurrent(true);
+    vector<std::thread> threads(num_threads);
+    for (unsigned i = 0; i < num_threads; ++i) {
+        threads[i] = std::thread([&, i]() {
+            for (unsigned j = 0; j < num_terms; ++j) {
+                expr_ref x(m.mk_const(symbol(j), b), m);
+                expr_ref y(m.mk_const(symbol(j + 1), b), m);
+                expr_ref tmp(m.mk_or(x, y), m);
+                results[i].push_back(m.mk_and(x, m.mk_not(y)));
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    m.set_concurrent(false);
+    for (unsigned i = 1; i < num_threads; ++i)
+        for (unsigned j = 0; j < num_terms; ++j)
+            ENSURE(results[i].get(j) == results[0].get(j));
+    for (auto& r : results)
+        r.reset();
+    ENSURE(m.get_num_asts() == num_asts);
+}
+#endif
+
+static void tst_bulk_release() {
+    ast_manager m;
+    sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+    app_ref x(m.mk_const(symbol("x"), s), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), s, s), m);
+    expr_ref e(x, m);
+    for (unsigned i = 0; i < 100; ++i)
+        e = m.mk_app(f, e.get());
+    unsigned num_asts = m.get_num_asts();
+    m.set_bulk_release();
+    e.reset();
+    f.reset();
+    // terms are kept until the manager is destroyed.
+    ENSURE(m.get_num_asts() == num_asts);
+}
+
+// nodes above the small object size are not owned by the allocator of the manager,
+// they are freed individually when a manager in bulk release mode is destroyed.
+static void tst_bulk_release_large_nodes() {
+    unsigned long long before = memory::get_allocation_size();
+    {
+        ast_manager m;
+        m.set_bulk_release();
+        sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+        ptr_vector<sort> domain;
+        for (unsigned i = 0; i < 64; ++i)
+            domain.push_back(s);
+        func_decl_ref f(m.mk_func_decl(symbol("f"), domain.size(), domain.data(), s), m);
+        expr_ref_vector args(m);
+        for (unsigned i = 0; i < 64; ++i)
+            args.push_back(m.mk_const(symbol(i), s));
+        expr_ref e(m);
+        for (unsigned i = 0; i < 10000; ++i) {
+            e = m.mk_app(f, args.size(), args.data());
+            ENSURE(m.get_node_size(e) >= 256);
+            args[i % args.size()] = e;
+        }
+    }
+    // about 6MB of nodes were allocated, memory counters are synchronized in steps of 100KB.
+    unsigned long long after = memory::get_allocation_size();
+    ENSURE(after < before + 1024 * 1024);
+}
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +230,10 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst_bulk_release();
+    tst_bulk_release_large_nodes();
+#ifndef SINGLE_THREAD
+    tst_concurrent();
+#endif
 }
 
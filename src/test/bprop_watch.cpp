@@ -0,0 +1,226 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    bprop_watch.cpp
+
+Abstract:
+
+    Tests for the watched columns of bound propagation (lp.bprop_watch_rows).
+
+    Two lar_solvers receive the same random rows, bounds, pushes and pops,
+    one with watched rows and one without. Rows with unbounded columns are
+    blocked until bounds are added, and become blocked again when the scopes
+    of the bounds are popped. The implied bounds of both solvers must be
+    identical after every feasibility check.
+
+--*/
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include "math/lp/lar_solver.h"
+#include "math/lp/lp_bound_propagator.h"
+#include "util/util.h"
+
+namespace {
+
+    struct test_propagator {
+        lp::lar_solver& m_lra;
+        test_propagator(lp::lar_solver& lra): m_lra(lra) {}
+        lp::lar_solver& lp() { return m_lra; }
+        lp::lar_solver const& lp() const { return m_lra; }
+        bool bound_is_interesting(unsigned, lp::lconstraint_kind, rational const&) const { return true; }
+        void consume(rational const&, lp::constraint_index) {}
+        bool is_equal(unsigned, unsigned) const { return false; }
+        bool add_eq(lp::lpvar, lp::lpvar, lp::explanation const&, bool) { return false; }
+    };
+
+    struct propagating_solver {
+        lp::lar_solver                         m_lra;
+        std_vector<lp::implied_bound>          m_ibounds;
+        test_propagator                        m_imp;
+        lp::lp_bound_propagator<test_propagator> m_bp;
+
+        propagating_solver(bool watch): m_imp(m_lra), m_bp(m_imp, m_ibounds) {
+            params_ref p;
+            p.set_bool("bprop_watch_rows", watch);
+            m_lra.updt_params(p);
+            m_lra.track_touched_rows(true);
+        }
+
+        // returns false if the bounds are infeasible
+        bool propagate() {
+            m_ibounds.clear();
+            if (m_lra.find_feasible_solution() == lp::lp_status::INFEASIBLE)
+                return false;
+            m_bp.init();
+            m_lra.propagate_bounds_for_touched_rows(m_bp);
+            return true;
+        }
+
+        std::string implied_bounds() const {
+            vector<std::string> bs;
+            for (auto const& b : m_ibounds)
+                bs.push_back(std::to_string(b.m_j) + (b.m_is_lower_bound ? " >" : " <") + (b.m_strict ? " " : "= ") + b.m_bound.to_string());
+            std::sort(bs.begin(), bs.end());
+            std::string r;
+            for (auto const& b : bs)
+                r += b + "\n";
+            return r;
+        }
+    };
+
+    class bprop_watch_test {
+        random_gen         m_rand;
+        propagating_solver m_watched, m_plain;
+        unsigned           m_num_vars;
+        unsigned           m_ext = 0;
+        unsigned           m_num_bounds = 0;
+        unsigned           m_num_checks = 0;
+
+        void add_var(bool is_int) {
+            m_watched.m_lra.add_var(m_ext, is_int);
+            m_plain.m_lra.add_var(m_ext, is_int);
+            ++m_ext;
+        }
+
+        void add_bound(lp::lpvar j, lp::lconstraint_kind k, rational const& rhs) {
+            m_watched.m_lra.add_var_bound(j, k, rhs);
+            m_plain.m_lra.add_var_bound(j, k, rhs);
+        }
+
+        lp::lpvar add_row(unsigned sz) {
+            vector<std::pair<rational, lp::lpvar>> coeffs;
+            for (unsigned i = 0; i < sz; ++i) {
+                lp::lpvar v = m_rand(m_num_vars);
+                if (any_of(coeffs, [&](auto const& p) { return p.second == v; }))
+                    continue;
+                int c = static_cast<int>(m_rand(7)) - 3;
+                coeffs.push_back({ rational(c == 0 ? 1 : c), v });
+            }
+            lp::lpvar t = m_watched.m_lra.add_term(coeffs, m_ext);
+            VERIFY(t == m_plain.m_lra.add_term(coeffs, m_ext));
+            ++m_ext;
+            return t;
+        }
+
+        void add_random_bound(unsigned num_columns) {
+            lp::lpvar j = m_rand(num_columns);
+            rational rhs(static_cast<int>(m_rand(21)) - 10);
+            static const lp::lconstraint_kind kinds[] = { lp::LE, lp::LT, lp::GE, lp::GT, lp::EQ };
+            add_bound(j, kinds[m_rand(5)], rhs);
+            ++m_num_bounds;
+        }
+
+        // returns true if the bounds are feasible
+        bool check() {
+            bool f1 = m_watched.propagate();
+            bool f2 = m_plain.propagate();
+            ENSURE(f1 == f2);
+            ENSURE(m_watched.implied_bounds() == m_plain.implied_bounds());
+            ++m_num_checks;
+            return f1;
+        }
+
+        void push() {
+            m_watched.m_lra.push();
+            m_plain.m_lra.push();
+        }
+
+        void pop(unsigned n) {
+            m_watched.m_lra.pop(n);
+            m_plain.m_lra.pop(n);
+        }
+
+    public:
+        bprop_watch_test(unsigned seed, unsigned num_vars):
+            m_rand(seed), m_watched(true), m_plain(false), m_num_vars(num_vars) {
+            for (unsigned i = 0; i < num_vars; ++i)
+                add_var(m_rand(2) == 0);
+        }
+
+        // x0 + x1 - x2 - x3 <= 10 is blocked until its columns are bounded,
+        // the bounds are added in a scope that is popped again.
+        void run_blocked_row() {
+            vector<std::pair<rational, lp::lpvar>> coeffs;
+            coeffs.push_back({ rational(1), 0 });
+            coeffs.push_back({ rational(1), 1 });
+            coeffs.push_back({ rational(-1), 2 });
+            coeffs.push_back({ rational(-1), 3 });
+            lp::lpvar t = m_watched.m_lra.add_term(coeffs, m_ext);
+            VERIFY(t == m_plain.m_lra.add_term(coeffs, m_ext));
+            ++m_ext;
+            add_bound(t, lp::LE, rational(10));
+            ENSURE(check());
+            unsigned skipped = m_watched.m_lra.stats().m_bprop_rows_skipped;
+            for (unsigned round = 0; round < 3; ++round) {
+                push();
+                add_bound(0, lp::GE, rational(round));
+                add_bound(1, lp::GE, rational(0));
+                add_bound(2, lp::LE, rational(round));
+                add_bound(3, lp::LE, rational(1));
+                ENSURE(check());
+                ENSURE(!m_watched.m_ibounds.empty());
+                pop(1);
+                add_bound(3, lp::LE, rational(5 - round));
+                ENSURE(check());
+            }
+            ENSURE(m_watched.m_lra.stats().m_bprop_rows_skipped > skipped);
+        }
+
+        void run_random(unsigned num_rows, unsigned num_steps) {
+            for (unsigned i = 0; i < num_rows; ++i)
+                add_row(2 + m_rand(4));
+            unsigned num_columns = m_watched.m_lra.number_of_vars();
+            // all bounds are added in scopes, so infeasible bounds can be popped
+            push();
+            unsigned scopes = 1;
+            for (unsigned i = 0; i < num_steps; ++i) {
+                unsigned op = m_rand(10);
+                if (op < 3) {
+                    push();
+                    ++scopes;
+                }
+                else if (op < 5 && scopes > 1) {
+                    unsigned n = 1 + m_rand(scopes - 1);
+                    pop(n);
+                    scopes -= n;
+                }
+                else
+                    add_random_bound(num_columns);
+                if (!check()) {
+                    pop(scopes);
+                    push();
+                    scopes = 1;
+                }
+            }
+        }
+
+        void display(std::ostream& out) {
+            auto const& st = m_watched.m_lra.stats();
+            out << "checks " << m_num_checks << " bounds " << m_num_bounds
+                << " rows skipped " << st.m_bprop_rows_skipped
+                << " rows analyzed " << st.m_bprop_rows_analyzed << "\n";
+        }
+
+        unsigned rows_skipped() { return m_watched.m_lra.stats().m_bprop_rows_skipped; }
+    };
+}
+
+void tst_bprop_watch() {
+    {
+        bprop_watch_test t(0, 4);
+        t.run_blocked_row();
+        t.display(std::cout);
+    }
+    unsigned skipped = 0;
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        bprop_watch_test t(seed, 8);
+        t.run_random(6, 200);
+        skipped += t.rows_skipped();
+    }
+    std::cout << "random rows skipped " << skipped << "\n";
+    ENSURE(skipped > 0);
+}
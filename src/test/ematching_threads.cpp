@@ -0,0 +1,118 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    ematching_threads.cpp
+
+Abstract:
+
+    Tests that matching the E-matching code trees with several threads
+    (smt.qi.ematching_threads) queues the same instances in the same order
+    as a single thread. The search then takes the same steps, so all
+    statistics other than timings agree. The benchmark chains case splits
+    over f, g and h, so each branch needs new instances and several code
+    trees are matched in the same round.
+
+--*/
+
+#include <iostream>
+#include <map>
+#include <sstream>
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/statistics.h"
+
+static char const* s_benchmark = R"(
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun h (U U) U)
+(declare-fun k (U) Int)
+(declare-fun p (U) Bool)
+(declare-const a0 U)
+(declare-const a1 U)
+(declare-const a2 U)
+(declare-const a3 U)
+(declare-const a4 U)
+(declare-const a5 U)
+(declare-const a6 U)
+(assert (forall ((x U)) (! (= (k (f x)) (+ (k x) 1)) :pattern ((f x)))))
+(assert (forall ((x U)) (! (= (k (g x)) (* 2 (k x))) :pattern ((g x)))))
+(assert (forall ((x U) (y U)) (! (= (k (h x y)) (+ (k x) (k y))) :pattern ((h x y)))))
+(assert (forall ((x U)) (! (=> (p x) (p (f x))) :pattern ((f x)))))
+(assert (forall ((x U)) (! (=> (p x) (p (g x))) :pattern ((g x)))))
+(assert (forall ((x U) (y U)) (! (=> (and (p x) (p y)) (p (h x y))) :pattern ((h x y)))))
+(assert (p a0))
+(assert (= (k a0) 1))
+(assert (or (= a1 (f a0)) (= a1 (g a0)) (= a1 (h a0 a0))))
+(assert (or (= a2 (f a1)) (= a2 (g a1)) (= a2 (h a1 a0))))
+(assert (or (= a3 (f a2)) (= a3 (g a2)) (= a3 (h a2 a0))))
+(assert (or (= a4 (f a3)) (= a4 (g a3)) (= a4 (h a3 a0))))
+(assert (or (= a5 (f a4)) (= a5 (g a4)) (= a5 (h a4 a0))))
+(assert (or (= a6 (f a5)) (= a6 (g a5)) (= a6 (h a5 a0))))
+(assert (or (not (p a6)) (< (k a6) 6)))
+)";
+
+typedef std::map<std::string, std::string> stats_t;
+
+static bool is_deterministic(std::string const& key) {
+    for (char const* k : { "time", "memory", "ematching-", "rlimit" })
+        if (key.find(k) != std::string::npos)
+            return false;
+    return true;
+}
+
+static lbool check(unsigned threads, stats_t& result, unsigned& parallel_rounds) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::istringstream in(s_benchmark);
+    VERIFY(parse_smt2_commands(ctx, in));
+    smt_params fparams;
+    fparams.m_qi_ematching_threads = threads;
+    smt::kernel solver(m, fparams);
+    for (expr* e : ctx.assertions())
+        solver.assert_expr(e);
+    lbool r = solver.check();
+    statistics st;
+    solver.collect_statistics(st);
+    parallel_rounds = 0;
+    for (unsigned i = 0; i < st.size(); ++i) {
+        std::string key = st.get_key(i);
+        if (key == "ematching-parallel-rounds")
+            parallel_rounds = st.get_uint_value(i);
+        if (!is_deterministic(key))
+            continue;
+        std::ostringstream strm;
+        if (st.is_uint(i))
+            strm << st.get_uint_value(i);
+        else
+            strm << st.get_double_value(i);
+        result[key] = strm.str();
+    }
+    return r;
+}
+
+void tst_ematching_threads() {
+    stats_t seq;
+    unsigned rounds = 0;
+    lbool r = check(1, seq, rounds);
+    std::cout << "result " << r << " instances " << seq["quant instantiations"] << "\n";
+    ENSURE(rounds == 0);
+    ENSURE(seq["quant instantiations"] != "" && seq["quant instantiations"] != "0");
+    for (unsigned threads : { 2, 4 }) {
+        stats_t par;
+        ENSURE(check(threads, par, rounds) == r);
+        std::cout << "threads " << threads << " parallel rounds " << rounds << "\n";
+        ENSURE(rounds > 1);
+        for (auto const& [k, v] : seq)
+            if (par[k] != v)
+                std::cout << k << ": " << v << " != " << par[k] << "\n";
+        ENSURE(par == seq);
+    }
+}
@@ -0,0 +1,122 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    fingerprints.cpp
+
+Abstract:
+
+    Tests for smt::fingerprint_set.
+
+    Random sequences of insert, contains, push_scope and pop_scope are checked
+    against a reference list of fingerprints. Fingerprints with the same
+    arguments share a hash, and pops remove many scopes at once.
+
+--*/
+
+#include <iostream>
+#include "ast/reg_decl_plugins.h"
+#include "params/smt_params.h"
+#include "smt/fingerprints.h"
+#include "smt/smt_context.h"
+#include "util/util.h"
+
+namespace {
+
+    struct entry {
+        void*                  m_data;
+        unsigned               m_hash;
+        ptr_vector<smt::enode> m_args;
+    };
+
+    bool same(entry const& e, void* data, unsigned n, smt::enode* const* args) {
+        if (e.m_data != data || e.m_args.size() != n)
+            return false;
+        for (unsigned i = 0; i < n; ++i)
+            if (e.m_args[i] != args[i])
+                return false;
+        return true;
+    }
+
+    bool model_contains(vector<entry> const& model, void* data, unsigned n, smt::enode* const* args) {
+        return any_of(model, [&](entry const& e) { return same(e, data, n, args); });
+    }
+}
+
+static void tst_random_ops(unsigned seed, unsigned num_ops) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params fparams;
+    smt::context ctx(m, fparams);
+    sort_ref s(m.mk_uninterpreted_sort(symbol("U")), m);
+    ptr_vector<smt::enode> nodes;
+    expr_ref_vector consts(m);
+    for (unsigned i = 0; i < 6; ++i) {
+        app* c = m.mk_const(symbol(i), s);
+        consts.push_back(c);
+        ctx.internalize(c, false);
+        nodes.push_back(ctx.get_enode(c));
+    }
+    // fingerprints with the same arguments but different data have the same hash
+    int data[3];
+    region r;
+    smt::fingerprint_set fps(m, r);
+    vector<entry> model, popped;
+    unsigned_vector scopes;
+    random_gen rand(seed);
+    unsigned max_size = 0, num_pops = 0;
+    smt::enode* args[2];
+    for (unsigned k = 0; k < num_ops; ++k) {
+        unsigned op = rand(20);
+        void* d = &data[rand(3)];
+        unsigned n = 1 + rand(2);
+        for (unsigned i = 0; i < n; ++i)
+            args[i] = nodes[rand(nodes.size())];
+        if (op < 12) {
+            bool found = model_contains(model, d, n, args);
+            smt::fingerprint* f = fps.insert(d, 0, n, args, nullptr);
+            ENSURE((f == nullptr) == found);
+            if (f) {
+                entry e;
+                e.m_data = d;
+                e.m_hash = f->get_data_hash();
+                e.m_args.append(n, args);
+                model.push_back(e);
+            }
+        }
+        else if (op < 15) {
+            // contains takes the hash computed by insert, so probe recorded fingerprints
+            vector<entry> const& es = popped.empty() || rand(2) == 0 ? model : popped;
+            if (!es.empty()) {
+                entry const& e = es[rand(es.size())];
+                bool found = model_contains(model, e.m_data, e.m_args.size(), e.m_args.data());
+                ENSURE(fps.contains(e.m_data, e.m_hash, e.m_args.size(), e.m_args.data()) == found);
+            }
+        }
+        else if (op < 18 && scopes.size() < 20) {
+            fps.push_scope();
+            scopes.push_back(model.size());
+        }
+        else if (!scopes.empty()) {
+            unsigned num_scopes = 1 + rand(scopes.size());
+            fps.pop_scope(num_scopes);
+            unsigned old_size = scopes[scopes.size() - num_scopes];
+            scopes.shrink(scopes.size() - num_scopes);
+            for (unsigned i = old_size; i < model.size(); ++i)
+                popped.push_back(model[i]);
+            model.shrink(old_size);
+            ++num_pops;
+        }
+        ENSURE(fps.size() == model.size());
+        max_size = std::max(max_size, fps.size());
+    }
+    for (entry const& e : model)
+        ENSURE(fps.contains(e.m_data, e.m_hash, e.m_args.size(), e.m_args.data()));
+    std::cout << "seed " << seed << " max size " << max_size << " pops " << num_pops << "\n";
+}
+
+void tst_fingerprints() {
+    for (unsigned seed = 0; seed < 10; ++seed)
+        tst_random_ops(seed, 3000);
+}
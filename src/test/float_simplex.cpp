@@ -0,0 +1,108 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.cpp
+
+Abstract:
+
+    Tests for the floating-point warm start of the exact simplex (lp.float_simplex).
+
+    Small random LPs are solved with and without the warm start. The verdicts
+    must agree, and the models found after the warm start must satisfy every
+    constraint exactly.
+
+--*/
+
+#include <iostream>
+#include "math/lp/lar_solver.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+namespace {
+
+    struct lp_row {
+        vector<std::pair<rational, lp::lpvar>> m_coeffs;
+        lp::lconstraint_kind m_kind;
+        rational m_rhs;
+    };
+
+    struct random_lp {
+        unsigned       m_num_vars;
+        vector<lp_row> m_rows;
+    };
+
+    random_lp mk_random_lp(random_gen& r, unsigned num_vars, unsigned num_rows) {
+        random_lp lp;
+        lp.m_num_vars = num_vars;
+        for (unsigned i = 0; i < num_rows; ++i) {
+            lp_row row;
+            for (unsigned j = 0; j < num_vars; ++j) {
+                int c = static_cast<int>(r(11)) - 5;
+                if (c != 0 && r(3) != 0)
+                    row.m_coeffs.push_back({ rational(c), j });
+            }
+            if (row.m_coeffs.empty())
+                row.m_coeffs.push_back({ rational::one(), r(num_vars) });
+            row.m_kind = r(2) == 0 ? lp::LE : lp::GE;
+            row.m_rhs = rational(static_cast<int>(r(41)) - 20);
+            lp.m_rows.push_back(row);
+        }
+        return lp;
+    }
+
+    lp::lp_status solve(random_lp const& lp, bool use_float, unsigned& calls, unsigned& pivots, unsigned& fallbacks) {
+        lp::lar_solver s;
+        params_ref p;
+        p.set_bool("float_simplex", use_float);
+        p.set_uint("float_simplex_min_rows", 0);
+        s.updt_params(p);
+        unsigned ext = 0;
+        for (unsigned j = 0; j < lp.m_num_vars; ++j) {
+            lp::lpvar v = s.add_var(ext++, false);
+            s.add_var_bound(v, lp::GE, rational(-10));
+            s.add_var_bound(v, lp::LE, rational(10));
+        }
+        for (auto const& row : lp.m_rows) {
+            lp::lpvar t = s.add_term(row.m_coeffs, ext++);
+            s.add_var_bound(t, row.m_kind, row.m_rhs);
+        }
+        lp::lp_status st = s.find_feasible_solution();
+        calls += s.settings().stats().m_float_simplex_calls;
+        pivots += s.settings().stats().m_float_simplex_pivots;
+        fallbacks += s.settings().stats().m_float_simplex_fallbacks;
+        if (st == lp::lp_status::INFEASIBLE)
+            return st;
+        for (auto const& row : lp.m_rows) {
+            rational sum;
+            for (auto const& [c, v] : row.m_coeffs)
+                sum += c * s.get_value(v);
+            ENSURE(row.m_kind == lp::LE ? sum <= row.m_rhs : sum >= row.m_rhs);
+        }
+        for (unsigned j = 0; j < lp.m_num_vars; ++j)
+            ENSURE(rational(-10) <= s.get_value(j) && s.get_value(j) <= rational(10));
+        return st;
+    }
+}
+
+void tst_float_simplex() {
+    random_gen r(0);
+    unsigned calls = 0, pivots = 0, fallbacks = 0, num_feasible = 0, num_infeasible = 0;
+    for (unsigned i = 0; i < 200; ++i) {
+        random_lp lp = mk_random_lp(r, 2 + r(8), 2 + r(12));
+        unsigned c = 0, p = 0, f = 0;
+        lp::lp_status exact = solve(lp, false, c, p, f);
+        lp::lp_status warm = solve(lp, true, calls, pivots, fallbacks);
+        bool exact_infeasible = exact == lp::lp_status::INFEASIBLE;
+        ENSURE(exact_infeasible == (warm == lp::lp_status::INFEASIBLE));
+        if (exact_infeasible)
+            ++num_infeasible;
+        else
+            ++num_feasible;
+    }
+    std::cout << "feasible " << num_feasible << " infeasible " << num_infeasible
+              << " float-simplex calls " << calls << " pivots " << pivots << " fallbacks " << fallbacks << "\n";
+    ENSURE(num_feasible > 0 && num_infeasible > 0);
+    ENSURE(calls > fallbacks && pivots > 0);
+}
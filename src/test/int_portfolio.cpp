@@ -0,0 +1,99 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    int_portfolio.cpp
+
+Abstract:
+
+    Tests for the ordering of the integer cut strategies (lp.int_portfolio).
+
+    Small random integer problems with equalities are solved with and
+    without the portfolio. The verdicts must agree, the models must satisfy
+    the constraints, and the portfolio must produce moves.
+
+--*/
+
+#include <cstring>
+#include <iostream>
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "model/model.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static void mk_random_ilp(ast_manager& m, random_gen& r, unsigned num_vars, unsigned num_rows, expr_ref_vector& fmls) {
+    arith_util a(m);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i < num_vars; ++i) {
+        expr* x = m.mk_const(symbol(i), a.mk_int());
+        xs.push_back(x);
+        fmls.push_back(a.mk_ge(x, a.mk_int(-20)));
+        fmls.push_back(a.mk_le(x, a.mk_int(20)));
+    }
+    for (unsigned i = 0; i < num_rows; ++i) {
+        expr_ref_vector sum(m);
+        for (unsigned j = 0; j < num_vars; ++j) {
+            int c = static_cast<int>(r(13)) - 6;
+            if (c != 0 && r(2) == 0)
+                sum.push_back(a.mk_mul(a.mk_int(c), xs.get(j)));
+        }
+        if (sum.size() < 2)
+            continue;
+        expr_ref lhs(a.mk_add(sum.size(), sum.data()), m);
+        expr_ref rhs(a.mk_int(static_cast<int>(r(21)) - 10), m);
+        switch (r(3)) {
+        case 0: fmls.push_back(m.mk_eq(lhs, rhs)); break;
+        case 1: fmls.push_back(a.mk_le(lhs, rhs)); break;
+        default: fmls.push_back(a.mk_ge(lhs, rhs)); break;
+        }
+    }
+}
+
+static lbool check(ast_manager& m, expr_ref_vector const& fmls, bool portfolio, unsigned& moves) {
+    smt_params fparams;
+    params_ref p;
+    p.set_bool("int_portfolio", portfolio);
+    smt::kernel s(m, fparams, p);
+    for (expr* e : fmls)
+        s.assert_expr(e);
+    lbool r = s.check();
+    if (r == l_true) {
+        model_ref mdl;
+        s.get_model(mdl);
+        for (expr* e : fmls)
+            ENSURE(mdl->is_true(e));
+    }
+    statistics st;
+    s.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), "arith-lia-portfolio-moves") == 0)
+            moves += st.get_uint_value(i);
+    return r;
+}
+
+void tst_int_portfolio() {
+    random_gen r(0);
+    unsigned moves = 0, num_sat = 0, num_unsat = 0;
+    for (unsigned i = 0; i < 60; ++i) {
+        ast_manager m;
+        reg_decl_plugins(m);
+        expr_ref_vector fmls(m);
+        mk_random_ilp(m, r, 3 + r(4), 2 + r(4), fmls);
+        unsigned ignore = 0;
+        lbool expected = check(m, fmls, false, ignore);
+        ENSURE(ignore == 0);
+        lbool res = check(m, fmls, true, moves);
+        ENSURE(res == expected);
+        if (res == l_true)
+            ++num_sat;
+        else if (res == l_false)
+            ++num_unsat;
+    }
+    std::cout << "sat " << num_sat << " unsat " << num_unsat << " portfolio moves " << moves << "\n";
+    ENSURE(num_sat > 0 && num_unsat > 0);
+    ENSURE(moves > 0);
+}
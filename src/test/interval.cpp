@@ -18,6 +18,7 @@ Revision History:
 --*/
 #include<cstdlib>
 #include "math/interval/interval_def.h"
+#include "math/interval/fp_interval.h"
 #include "util/dependency.h"
 #include "util/mpq.h"
 #include "ast/ast.h"
@@ -452,7 +453,55 @@ static void tst_pi_float() {
 #define SMALL_MAG 3
 #define MID_MAG   10
 
+// the exact value v lies within the error radius of the floating-point bound b
+static bool fp_bound_covers(fp_interval::bound const& b, rational const& v) {
+    if (b.m_inf)
+        return false;
+    return std::fabs(v.get_double() - b.m_val) <= b.m_err * (1 + 1e-6) + 1e-300;
+}
+
+static rational random_rational() {
+    return rational(static_cast<int>(rand() % 2001) - 1000, static_cast<int>(rand() % 97) + 1);
+}
+
+static void tst_fp_interval(unsigned num_tests) {
+    for (unsigned i = 0; i < num_tests; i++) {
+        rational a1 = random_rational(), a2 = random_rational(), b1 = random_rational(), b2 = random_rational();
+        if (a1 > a2) std::swap(a1, a2);
+        if (b1 > b2) std::swap(b1, b2);
+        fp_interval a, b, s, m, p;
+        VERIFY(a.set_lower(a1) && a.set_upper(a2) && b.set_lower(b1) && b.set_upper(b2));
+        VERIFY(fp_interval::add(a, b, s));
+        VERIFY(fp_bound_covers(s.lower(), a1 + b1) && fp_bound_covers(s.upper(), a2 + b2));
+        VERIFY(fp_interval::mul(a, b, m));
+        rational ps[4] = { a1 * b1, a1 * b2, a2 * b1, a2 * b2 };
+        rational lo = ps[0], hi = ps[0];
+        for (rational const& q : ps) {
+            lo = std::min(lo, q);
+            hi = std::max(hi, q);
+        }
+        VERIFY(fp_bound_covers(m.lower(), lo) && fp_bound_covers(m.upper(), hi));
+        if (m.contains_zero())
+            VERIFY(lo.is_neg() && hi.is_pos());
+        if (fp_interval::power(a, 2, p)) {
+            rational plo = a1.is_neg() && a2.is_pos() ? rational::zero() : std::min(a1 * a1, a2 * a2);
+            VERIFY(fp_bound_covers(p.lower(), plo) && fp_bound_covers(p.upper(), std::max(a1 * a1, a2 * a2)));
+        }
+    }
+    // unbounded intervals
+    fp_interval a, b, m;
+    VERIFY(a.set_lower(rational(1)));
+    a.set_upper_inf();
+    VERIFY(b.set_lower(rational(-2)) && b.set_upper(rational(3)));
+    VERIFY(fp_interval::mul(a, b, m));
+    VERIFY(m.lower().m_inf && m.upper().m_inf && m.contains_zero());
+    VERIFY(b.set_lower(rational(0)) && b.set_upper(rational(0)));
+    VERIFY(fp_interval::mul(a, b, m));
+    VERIFY(m.lower().is_zero() && m.upper().is_zero() && !m.contains_zero());
+}
+
 void tst_interval() {
+    tst_fp_interval(NUM_TESTS);
     // enable_trace("interval_bug");
     // tst_float();
     // return;
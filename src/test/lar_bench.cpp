@@ -0,0 +1,361 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    lar_bench.cpp
+
+Abstract:
+
+    Benchmark harness for lar_solver.
+
+    Usage: test-z3 lar_bench file1.smt2 file2.smt2 ... [lp.foo=val smt.arith.bar=val]
+
+    Every argument that is neither a global parameter nor an option of
+    test-z3 is a file, including absolute paths. Unknown options are
+    reported as skipped.
+
+    Each file is a conjunction of linear (in)equalities over integer and real
+    constants in SMT-LIB2. The constraints are loaded into a lar_solver directly,
+    without the SMT core. Real problems are solved by find_feasible_solution,
+    integer problems by a depth-first branch and bound on top of int_solver that
+    adds the cuts of int_solver at the current node. Bound propagation runs after
+    every feasibility check.
+
+    For each file one line is printed:
+    (lar-bench :file "name" :status sat :time 0.12 :bprop-time 0.01 :nodes 3 :cuts 2 :arith-... )
+    Global parameters given on the command line are passed to lar_solver.
+
+--*/
+
+#include <fstream>
+#include <iostream>
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "math/lp/lar_solver.h"
+#include "math/lp/int_solver.h"
+#include "util/gparams.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+
+namespace {
+
+    // implied bounds are collected but not used, equalities are not propagated.
+    struct bench_propagator {
+        lp::lar_solver& m_lra;
+        bench_propagator(lp::lar_solver& lra): m_lra(lra) {}
+        lp::lar_solver& lp() { return m_lra; }
+        lp::lar_solver const& lp() const { return m_lra; }
+        bool bound_is_interesting(unsigned, lp::lconstraint_kind, rational const&) const { return true; }
+        void consume(rational const&, lp::constraint_index) {}
+        bool is_equal(unsigned, unsigned) const { return false; }
+        bool add_eq(lp::lpvar, lp::lpvar, lp::explanation const&, bool) { return false; }
+    };
+
+    class lar_bench {
+        ast_manager&            m;
+        arith_util              a;
+        lp::lar_solver          m_lra;
+        lp::int_solver          m_lia;
+        obj_map<expr, lp::lpvar> m_vars;
+        unsigned                m_ext = 0;
+        bool                    m_has_int = false;
+        std_vector<lp::implied_bound> m_ibounds;
+        bench_propagator        m_imp;
+        lp::lp_bound_propagator<bench_propagator> m_bp;
+        stopwatch               m_bprop_watch;
+        unsigned                m_nodes = 0;
+        unsigned                m_cuts = 0;
+        unsigned                m_branches = 0;
+        unsigned                m_implied_bounds = 0;
+        unsigned                m_max_nodes = 100000;
+
+        typedef vector<std::pair<rational, lp::lpvar>> coeffs_t;
+
+        lp::lpvar mk_var(expr* e) {
+            lp::lpvar v;
+            if (m_vars.find(e, v))
+                return v;
+            bool is_int = a.is_int(e);
+            m_has_int |= is_int;
+            v = m_lra.add_var(m_ext++, is_int);
+            m_vars.insert(e, v);
+            return v;
+        }
+
+        // accumulate mul * e into coeffs and offset
+        bool linearize(expr* e, rational const& mul, coeffs_t& coeffs, rational& offset) {
+            rational r;
+            expr* x, * y;
+            if (a.is_numeral(e, r)) {
+                offset += mul * r;
+                return true;
+            }
+            if (a.is_add(e)) {
+                for (expr* arg : *to_app(e))
+                    if (!linearize(arg, mul, coeffs, offset))
+                        return false;
+                return true;
+            }
+            if (a.is_sub(e)) {
+                app* s = to_app(e);
+                if (!linearize(s->get_arg(0), mul, coeffs, offset))
+                    return false;
+                for (unsigned i = 1; i < s->get_num_args(); ++i)
+                    if (!linearize(s->get_arg(i), -mul, coeffs, offset))
+                        return false;
+                return true;
+            }
+            if (a.is_uminus(e, x))
+                return linearize(x, -mul, coeffs, offset);
+            if (a.is_to_real(e, x))
+                return linearize(x, mul, coeffs, offset);
+            if (a.is_mul(e, x, y) && a.is_numeral(x, r))
+                return linearize(y, mul * r, coeffs, offset);
+            if (a.is_mul(e, x, y) && a.is_numeral(y, r))
+                return linearize(x, mul * r, coeffs, offset);
+            if (is_uninterp_const(e) && a.is_int_real(e)) {
+                coeffs.push_back({ mul, mk_var(e) });
+                return true;
+            }
+            return false;
+        }
+
+        // add lhs k rhs, return false if the constraint is not linear
+        bool add_atom(expr* lhs, lp::lconstraint_kind k, expr* rhs, bool& trivially_false) {
+            coeffs_t coeffs, merged;
+            rational offset;
+            if (!linearize(lhs, rational::one(), coeffs, offset) || !linearize(rhs, rational::minus_one(), coeffs, offset))
+                return false;
+            u_map<unsigned> pos;
+            for (auto const& [c, v] : coeffs) {
+                unsigned i;
+                if (pos.find(v, i))
+                    merged[i].first += c;
+                else {
+                    pos.insert(v, merged.size());
+                    merged.push_back({ c, v });
+                }
+            }
+            unsigned j = 0;
+            for (auto const& p : merged)
+                if (!p.first.is_zero())
+                    merged[j++] = p;
+            merged.shrink(j);
+            // sum of merged + offset k 0
+            rational rs = -offset;
+            if (merged.empty()) {
+                switch (k) {
+                case lp::LE: trivially_false |= rs.is_neg(); break;
+                case lp::LT: trivially_false |= !rs.is_pos(); break;
+                case lp::GE: trivially_false |= rs.is_pos(); break;
+                case lp::GT: trivially_false |= !rs.is_neg(); break;
+                default: trivially_false |= !rs.is_zero(); break;
+                }
+                return true;
+            }
+            lp::lpvar t = m_lra.add_term(merged, m_ext++);
+            m_lra.add_var_bound(t, k, rs);
+            return true;
+        }
+
+        bool add_assertion(expr* e, bool& trivially_false) {
+            expr* x, * y;
+            bool neg = m.is_not(e, e);
+            if (!neg && m.is_and(e)) {
+                for (expr* arg : *to_app(e))
+                    if (!add_assertion(arg, trivially_false))
+                        return false;
+                return true;
+            }
+            if (m.is_true(e) || m.is_false(e)) {
+                trivially_false |= m.is_true(e) == neg;
+                return true;
+            }
+            if (a.is_le(e, x, y))
+                return add_atom(x, neg ? lp::GT : lp::LE, y, trivially_false);
+            if (a.is_ge(e, x, y))
+                return add_atom(x, neg ? lp::LT : lp::GE, y, trivially_false);
+            if (a.is_lt(e, x, y))
+                return add_atom(x, neg ? lp::GE : lp::LT, y, trivially_false);
+            if (a.is_gt(e, x, y))
+                return add_atom(x, neg ? lp::LE : lp::GT, y, trivially_false);
+            if (!neg && m.is_eq(e, x, y) && a.is_int_real(x))
+                return add_atom(x, lp::EQ, y, trivially_false);
+            return false;
+        }
+
+        lp::lp_status check_lp() {
+            lp::lp_status st = m_lra.find_feasible_solution();
+            if (st == lp::lp_status::INFEASIBLE || !m_lra.settings().bound_propagation())
+                return st;
+            m_bprop_watch.start();
+            m_ibounds.clear();
+            m_bp.init();
+            m_lra.propagate_bounds_for_touched_rows(m_bp);
+            m_implied_bounds += m_ibounds.size();
+            m_bprop_watch.stop();
+            return st;
+        }
+
+        // add term k offset as a bound at the current scope
+        void add_bound(lp::lar_term const& t, lp::lconstraint_kind k, rational const& offset) {
+            coeffs_t coeffs;
+            for (lp::lar_term::ival p : t)
+                coeffs.push_back({ p.coeff(), p.j() });
+            lp::lpvar j = m_lra.add_term(coeffs, m_ext++);
+            m_lra.add_var_bound(j, k, offset);
+        }
+
+        // depth-first branch and bound
+        lbool search() {
+            if (++m_nodes > m_max_nodes || m_lra.settings().get_cancel_flag())
+                return l_undef;
+            unsigned rounds = 0;
+            while (true) {
+                if (check_lp() == lp::lp_status::INFEASIBLE)
+                    return l_false;
+                if (!m_lra.has_inf_int())
+                    return l_true;
+                lp::explanation ex;
+                switch (m_lia.check(&ex)) {
+                case lp::lia_move::sat:
+                    return l_true;
+                case lp::lia_move::conflict:
+                    return l_false;
+                case lp::lia_move::cut:
+                    ++m_cuts;
+                    add_bound(m_lia.get_term(), m_lia.is_upper() ? lp::LE : lp::GE, m_lia.offset());
+                    break;
+                case lp::lia_move::branch: {
+                    ++m_branches;
+                    lp::lar_term t = m_lia.get_term();
+                    rational k = m_lia.offset();
+                    bool upper = m_lia.is_upper();
+                    m_lra.push();
+                    add_bound(t, upper ? lp::LE : lp::GE, k);
+                    lbool r = search();
+                    m_lra.pop(1);
+                    if (r != l_false)
+                        return r;
+                    m_lra.push();
+                    add_bound(t, upper ? lp::GT : lp::LT, k);
+                    r = search();
+                    m_lra.pop(1);
+                    return r;
+                }
+                default:
+                    if (++rounds > 100)
+                        return l_undef;
+                    break;
+                }
+            }
+        }
+
+    public:
+        lar_bench(ast_manager& m):
+            m(m), a(m), m_lia(m_lra), m_imp(m_lra), m_bp(m_imp, m_ibounds) {
+            m_lra.updt_params(params_ref());
+        }
+
+        bool load(expr_ref_vector const& fmls, bool& trivially_false) {
+            for (expr* e : fmls)
+                if (!add_assertion(e, trivially_false))
+                    return false;
+            return true;
+        }
+
+        lbool solve() {
+            if (!m_has_int)
+                return check_lp() == lp::lp_status::INFEASIBLE ? l_false : l_true;
+            return search();
+        }
+
+        void display(std::ostream& out, char const* file_name, char const* status, double time) {
+            statistics st;
+            m_lra.settings().stats().collect_statistics(st);
+            out << "(lar-bench :file \"" << file_name << "\" :status " << status
+                << " :time " << time
+                << " :bprop-time " << m_bprop_watch.get_seconds()
+                << " :implied-bounds " << m_implied_bounds
+                << " :nodes " << m_nodes
+                << " :branches " << m_branches
+                << " :cuts " << m_cuts;
+            for (unsigned i = 0; i < st.size(); ++i) {
+                out << " :" << st.get_key(i) << " ";
+                if (st.is_uint(i))
+                    out << st.get_uint_value(i);
+                else
+                    out << st.get_double_value(i);
+            }
+            out << ")" << std::endl;
+        }
+    };
+}
+
+static void bench_file(char const* file_name) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::ifstream in(file_name);
+    if (in.bad() || in.fail()) {
+        std::cout << "(lar-bench :file \"" << file_name << "\" :status error :reason \"cannot open file\")" << std::endl;
+        return;
+    }
+    if (!parse_smt2_commands(ctx, in)) {
+        std::cout << "(lar-bench :file \"" << file_name << "\" :status error :reason \"parse error\")" << std::endl;
+        return;
+    }
+    expr_ref_vector fmls(m);
+    for (expr* e : ctx.assertions())
+        fmls.push_back(e);
+    lar_bench b(m);
+    stopwatch sw;
+    sw.start();
+    bool trivially_false = false;
+    if (!b.load(fmls, trivially_false)) {
+        std::cout << "(lar-bench :file \"" << file_name << "\" :status unsupported)" << std::endl;
+        return;
+    }
+    lbool r = trivially_false ? l_false : b.solve();
+    sw.stop();
+    b.display(std::cout, file_name, r == l_true ? "sat" : r == l_false ? "unsat" : "unknown", sw.get_seconds());
+}
+
+// options of main, which cuts option arguments at ':'
+static bool is_main_option(char const* arg) {
+    if (arg[0] != '-' && arg[0] != '/')
+        return false;
+    for (char const* opt : { "h", "?", "v", "w", "a", "tr", "dbg" })
+        if (strcmp(arg + 1, opt) == 0)
+            return true;
+    return false;
+}
+
+// global parameters are set by main, which cuts them at '='
+static bool is_parameter(char const* arg) {
+    if (strchr(arg, '='))
+        return true;
+    try {
+        gparams::get_value(arg);
+        return true;
+    }
+    catch (z3_exception&) {
+        return false;
+    }
+}
+
+void tst_lar_bench(char** argv, int argc, int& i) {
+    for (; i + 1 < argc; ++i) {
+        char const* arg = argv[i + 1];
+        if (is_main_option(arg) || is_parameter(arg))
+            continue;
+        if (arg[0] == '-')
+            std::cout << "(lar-bench :file \"" << arg << "\" :status skipped :reason \"unknown option\")" << std::endl;
+        else
+            bench_file(arg);
+    }
+}
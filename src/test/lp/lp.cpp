@@ -469,6 +469,8 @@ bool contains(std::string const &s, char const *pattern) {
 
 void setup_args_parser(argument_parser &parser) {
     parser.add_option_with_help_string("-add_rows", "test add_rows of static matrix");
+    parser.add_option_with_help_string("-pivot_bench", "benchmark pivoting in static matrix");
+    parser.add_option_with_help_string("-push_pop_bench", "benchmark push/assert/check/pop cycles of lar_solver");
     parser.add_option_with_help_string("-monics", "test emonics");
     parser.add_option_with_help_string("-nex_order", "test nex order");
     parser.add_option_with_help_string("-nla_cn", "test cross nornmal form");
@@ -1760,6 +1762,113 @@ void test_gomory_cut() {
         SASSERT(matrix.get_elem(1, 2) == 4); // unchanged
     }
     
+// Pivot a random sparse tableau, the way lp_core_solver_base::pivot_column_tableau does,
+// and report the time spent in static_matrix row operations.
+void test_pivot_bench() {
+    unsigned m = 3000, n = 6000, row_len = 4, num_pivots = 3000;
+    lp::static_matrix<mpq, impq> A;
+    A.init_empty_matrix(m, n);
+    srand(31);
+    std_vector<int> heading(n, -1);
+    std_vector<unsigned> basis;
+    for (unsigned i = 0; i < m; i++) {
+        A.set(i, i, mpq(1));
+        heading[i] = i;
+        basis.push_back(i);
+        for (unsigned k = 0; k < row_len; k++) {
+            unsigned j = m + rand() % (n - m);
+            if (A.get_elem(i, j).is_zero())
+                A.set(i, j, mpq(rand() % 2 ? 1 : -1));
+        }
+    }
+    stopwatch sw;
+    sw.start();
+    unsigned pivots = 0;
+    for (unsigned p = 0; p < num_pivots; p++) {
+        unsigned j = rand() % n;
+        if (heading[j] >= 0 || A.m_columns[j].empty())
+            continue;
+        auto & column = A.m_columns[j];
+        unsigned r = column[rand() % column.size()].var();
+        unsigned k = 0;
+        while (column[k].var() != r)
+            k++;
+        if (k != 0) {
+            auto c = column[0];
+            column[0] = column[k];
+            column[k] = c;
+            A.m_rows[r][column[0].offset()].offset() = 0;
+            A.m_rows[c.var()][c.offset()].offset() = k;
+        }
+        mpq a = A.get_val(column[0]);
+        A.divide_row(r, a);
+        while (column.size() > 1)
+            A.pivot_row_to_row_given_cell(r, column.back(), j);
+        unsigned leaving = basis[r];
+        heading[leaving] = -1;
+        heading[j] = r;
+        basis[r] = j;
+        if (p % 8 == 0) {
+            unsigned r2 = rand() % m;
+            if (r2 != r) {
+                A.transpose_rows(r, r2);
+                std::swap(basis[r], basis[r2]);
+                heading[basis[r]] = r;
+                heading[basis[r2]] = r2;
+            }
+        }
+        pivots++;
+    }
+    sw.stop();
+    std::cout << "static_matrix pivots: " << pivots << " non-zeroes: " << A.number_of_non_zeroes()
+              << " time: " << sw.get_seconds() << "s" << std::endl;
+    SASSERT(A.is_correct());
+}
+
+// Run push, assert bounds on terms, check feasibility and pop on a random problem, the
+// way an incremental client of lar_solver does, and report the time per cycle.
+void test_push_pop_bench() {
+    unsigned num_vars = 300, num_terms = 300, term_len = 4, num_cycles = 2000, bounds_per_cycle = 6;
+    lar_solver solver;
+    srand(17);
+    vector<lpvar> vars;
+    for (unsigned i = 0; i < num_vars; i++) {
+        lpvar x = solver.add_var(i, false);
+        solver.add_var_bound(x, lconstraint_kind::GE, mpq(-10));
+        solver.add_var_bound(x, lconstraint_kind::LE, mpq(10));
+        vars.push_back(x);
+    }
+    vector<lpvar> terms;
+    for (unsigned i = 0; i < num_terms; i++) {
+        vector<std::pair<mpq, lpvar>> coeffs;
+        unsigned first = rand() % (num_vars - term_len);
+        for (unsigned k = 0; k < term_len; k++) {
+            int a = static_cast<int>(rand() % 3) + 1;
+            coeffs.push_back(std::make_pair(mpq(rand() % 2 ? a : -a), vars[first + k]));
+        }
+        terms.push_back(solver.add_term(coeffs, num_vars + i));
+    }
+    VERIFY(solver.find_feasible_solution() == lp_status::OPTIMAL);
+    stopwatch sw;
+    sw.start();
+    unsigned num_feasible = 0;
+    for (unsigned c = 0; c < num_cycles; c++) {
+        solver.push();
+        for (unsigned k = 0; k < bounds_per_cycle; k++) {
+            lpvar t = terms[rand() % num_terms];
+            mpq b(static_cast<int>(rand() % 21) - 10);
+            solver.add_var_bound(t, rand() % 2 ? lconstraint_kind::LE : lconstraint_kind::GE, b);
+        }
+        if (solver.find_feasible_solution() == lp_status::OPTIMAL)
+            num_feasible++;
+        solver.pop(1);
+    }
+    sw.stop();
+    VERIFY(solver.find_feasible_solution() == lp_status::OPTIMAL);
+    std::cout << "lar_solver push/pop cycles: " << num_cycles << " feasible: " << num_feasible
+              << " time: " << sw.get_seconds() << "s" << std::endl;
+}
+
 void test_nla_order_lemma() { nla::test_order_lemma(); }
 
 void test_lp_local(int argn, char **argv) {
@@ -1780,6 +1889,14 @@ void test_lp_local(int argn, char **argv) {
         test_add_rows();
         return finalize(0);
     }
+    if (args_parser.option_is_used("-pivot_bench")) {
+        test_pivot_bench();
+        return finalize(0);
+    }
+    if (args_parser.option_is_used("-push_pop_bench")) {
+        test_push_pop_bench();
+        return finalize(0);
+    }
     if (args_parser.option_is_used("-monics")) {
         nla::test_monics();
         return finalize(0);
@@ -203,6 +203,11 @@ int main(int argc, char ** argv) {
     TST(arith_rewriter);
     TST(check_assumptions);
     TST(smt_context);
+    TST(fingerprints);
+    TST(ematching_threads);
+    TST(qi_profile);
+    TST(qi_throttle);
+    TST(smt_work_stealing);
     TST(theory_dl);
     TST(model_retrieval);
     TST(model_based_opt);
@@ -248,6 +253,12 @@ int main(int argc, char ** argv) {
     TST(theory_pb);
     TST(simplex);
     TST(sat_user_scope);
+    TST(sat_cache);
+    TST(sat_elim_vars);
+    TST(float_simplex);
+    TST(int_portfolio);
+    TST(bprop_watch);
+    TST(term_gcd_bounds);
     TST_ARGV(ddnf);
     TST(ddnf1);
     TST(model_evaluator);
@@ -256,6 +267,9 @@ int main(int argc, char ** argv) {
     TST_ARGV(sat_lookahead);
     TST_ARGV(sat_local_search);
     TST_ARGV(cnf_backbones);
+    TST_ARGV(lar_bench);
+    TST(smt_push_pop);
+    TST_ARGV(smt_push_pop_bench);
     TST(bdd);
     TST(pdd);
     TST(pdd_solver);
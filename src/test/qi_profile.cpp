@@ -0,0 +1,331 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    qi_profile.cpp
+
+Abstract:
+
+    Tests for the per-quantifier instantiation profile (smt.qi.profile and
+    smt.qi.profile_file).
+
+    An unsatisfiable benchmark whose case splits need instances is solved
+    with the profile enabled, so instances take part in conflicts. A second
+    benchmark has a matching loop and is stopped by smt.qi.max_instances.
+    The statistics and the JSON file written after each check are compared
+    with each other.
+
+--*/
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ast/quantifier_stat.h"
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/statistics.h"
+
+static char const* s_conflicts = R"(
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun k (U) Int)
+(declare-fun p (U) Bool)
+(declare-const a0 U)
+(declare-const a1 U)
+(declare-const a2 U)
+(declare-const a3 U)
+(declare-const a4 U)
+(assert (forall ((x U)) (! (= (k (f x)) (+ (k x) 1)) :pattern ((f x)) :qid kf)))
+(assert (forall ((x U)) (! (= (k (g x)) (* 2 (k x))) :pattern ((g x)) :qid kg)))
+(assert (forall ((x U)) (! (=> (p x) (p (f x))) :pattern ((f x)) :qid pf)))
+(assert (forall ((x U)) (! (=> (p x) (p (g x))) :pattern ((g x)) :qid pg)))
+(assert (p a0))
+(assert (= (k a0) 1))
+(assert (or (= a1 (f a0)) (= a1 (g a0))))
+(assert (or (= a2 (f a1)) (= a2 (g a1))))
+(assert (or (= a3 (f a2)) (= a3 (g a2))))
+(assert (or (= a4 (f a3)) (= a4 (g a3))))
+(assert (or (not (p a4)) (< (k a4) 5)))
+)";
+
+// every instance of loop creates a term of the next generation that matches its pattern
+static char const* s_loop = R"(
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-const a U)
+(assert (forall ((x U)) (! (= (f x) (f (g x))) :pattern ((f x)) :qid loop)))
+(assert (= (f a) a))
+)";
+
+namespace {
+
+    // a minimal JSON reader for the profile
+    struct json_value {
+        enum kind_t { null_k, bool_k, number_k, string_k, array_k, object_k };
+        kind_t                                         m_kind = null_k;
+        bool                                           m_bool = false;
+        double                                         m_number = 0;
+        std::string                                    m_string;
+        std::vector<json_value>                        m_array;
+        std::vector<std::pair<std::string, json_value>> m_object;
+
+        json_value const* get(char const* key) const {
+            for (auto const& [k, v] : m_object)
+                if (k == key)
+                    return &v;
+            return nullptr;
+        }
+    };
+
+    class json_reader {
+        std::string const& m_in;
+        size_t             m_pos = 0;
+
+        void skip_ws() {
+            while (m_pos < m_in.size() && isspace(static_cast<unsigned char>(m_in[m_pos])))
+                ++m_pos;
+        }
+
+        bool expect(char c) {
+            skip_ws();
+            if (m_pos >= m_in.size() || m_in[m_pos] != c)
+                return false;
+            ++m_pos;
+            return true;
+        }
+
+        bool keyword(char const* kw) {
+            std::string s(kw);
+            if (m_in.compare(m_pos, s.size(), s) != 0)
+                return false;
+            m_pos += s.size();
+            return true;
+        }
+
+        bool read_string(std::string& s) {
+            if (!expect('"'))
+                return false;
+            for (; m_pos < m_in.size() && m_in[m_pos] != '"'; ++m_pos) {
+                if (m_in[m_pos] == '\\' && ++m_pos == m_in.size())
+                    return false;
+                s.push_back(m_in[m_pos]);
+            }
+            return expect('"');
+        }
+
+    public:
+        json_reader(std::string const& in): m_in(in) {}
+
+        bool read(json_value& v) {
+            skip_ws();
+            if (m_pos >= m_in.size())
+                return false;
+            char c = m_in[m_pos];
+            if (c == '{') {
+                v.m_kind = json_value::object_k;
+                ++m_pos;
+                if (expect('}'))
+                    return true;
+                do {
+                    std::pair<std::string, json_value> kv;
+                    if (!read_string(kv.first) || !expect(':') || !read(kv.second))
+                        return false;
+                    v.m_object.push_back(kv);
+                }
+                while (expect(','));
+                return expect('}');
+            }
+            if (c == '[') {
+                v.m_kind = json_value::array_k;
+                ++m_pos;
+                if (expect(']'))
+                    return true;
+                do {
+                    v.m_array.push_back(json_value());
+                    if (!read(v.m_array.back()))
+                        return false;
+                }
+                while (expect(','));
+                return expect(']');
+            }
+            if (c == '"') {
+                v.m_kind = json_value::string_k;
+                return read_string(v.m_string);
+            }
+            if (keyword("true")) {
+                v.m_kind = json_value::bool_k;
+                v.m_bool = true;
+                return true;
+            }
+            if (keyword("false")) {
+                v.m_kind = json_value::bool_k;
+                return true;
+            }
+            if (keyword("null"))
+                return true;
+            char const* begin = m_in.c_str() + m_pos;
+            char* end = nullptr;
+            v.m_kind = json_value::number_k;
+            v.m_number = strtod(begin, &end);
+            if (end == begin)
+                return false;
+            m_pos += end - begin;
+            return true;
+        }
+
+        bool at_end() {
+            skip_ws();
+            return m_pos == m_in.size();
+        }
+    };
+
+    struct profile_result {
+        lbool    m_result = l_undef;
+        unsigned m_matches = 0;
+        unsigned m_instances = 0;
+        unsigned m_conflicts = 0;
+        unsigned m_matching_loops = 0;
+        json_value m_profile;
+    };
+}
+
+// statistics with value 0 are not reported
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static void solve(char const* benchmark, smt_params& fparams, profile_result& r) {
+    char const* file_name = "qi_profile_test.json";
+    std::remove(file_name);
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::istringstream in(benchmark);
+    VERIFY(parse_smt2_commands(ctx, in));
+    fparams.m_qi_profile = true;
+    fparams.m_qi_profile_file = file_name;
+    smt::kernel solver(m, fparams);
+    for (expr* e : ctx.assertions())
+        solver.assert_expr(e);
+    r.m_result = solver.check();
+    statistics st;
+    solver.collect_statistics(st);
+    r.m_matches = get_stat(st, "quant matches");
+    r.m_instances = get_stat(st, "quant instantiations");
+    r.m_conflicts = get_stat(st, "quant instance conflicts");
+    r.m_matching_loops = get_stat(st, "quant matching loops");
+
+    std::ifstream f(file_name);
+    ENSURE(f.good());
+    std::stringstream buffer;
+    buffer << f.rdbuf();
+    f.close();
+    std::remove(file_name);
+    std::string text = buffer.str();
+    json_reader reader(text);
+    ENSURE(reader.read(r.m_profile) && reader.at_end());
+}
+
+// the profile of each quantifier is consistent, its totals agree with the statistics.
+static void check_profile(profile_result const& r) {
+    json_value const* qs = r.m_profile.get("quantifiers");
+    ENSURE(qs && qs->m_kind == json_value::array_k && !qs->m_array.empty());
+    double matches = 0, instances = 0, conflicts = 0;
+    unsigned loops = 0;
+    for (json_value const& q : qs->m_array) {
+        for (char const* key : { "weight", "matches", "instances", "checker_sat", "simplify_true", "conflicts",
+                                 "conflict_score", "max_generation", "max_cost", "instantiate_time" }) {
+            json_value const* v = q.get(key);
+            ENSURE(v && v->m_kind == json_value::number_k && v->m_number >= 0);
+        }
+        ENSURE(q.get("qid") && q.get("qid")->m_kind == json_value::string_k);
+        json_value const* gens = q.get("generations");
+        ENSURE(gens && gens->m_array.size() == q::quantifier_stat::num_generation_buckets());
+        double num_instances = q.get("instances")->m_number, sum = 0;
+        for (json_value const& g : gens->m_array)
+            sum += g.m_number;
+        ENSURE(sum == num_instances);
+        // the highest non-empty bucket contains the maximal generation
+        unsigned top = 0;
+        for (unsigned b = 0; b < gens->m_array.size(); ++b)
+            if (gens->m_array[b].m_number > 0)
+                top = b;
+        if (num_instances > 0) {
+            ENSURE(top == q::quantifier_stat::generation_bucket(static_cast<unsigned>(q.get("max_generation")->m_number)));
+        }
+        json_value const* loop = q.get("matching_loop");
+        ENSURE(loop && loop->m_kind == json_value::bool_k);
+        if (loop->m_bool)
+            ++loops;
+        matches += q.get("matches")->m_number;
+        instances += num_instances;
+        conflicts += q.get("conflicts")->m_number;
+    }
+    ENSURE(matches == r.m_matches);
+    ENSURE(instances == r.m_instances);
+    ENSURE(conflicts == r.m_conflicts);
+    ENSURE(loops == r.m_matching_loops);
+}
+
+static void tst_generation_buckets() {
+    unsigned expected[] = { 0, 1, 2, 3, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 6 };
+    for (unsigned g = 0; g < sizeof(expected) / sizeof(expected[0]); ++g)
+        ENSURE(q::quantifier_stat::generation_bucket(g) == expected[g]);
+    ENSURE(q::quantifier_stat::generation_bucket(31) == 6);
+    ENSURE(q::quantifier_stat::generation_bucket(32) == 7);
+    ENSURE(q::quantifier_stat::generation_bucket(UINT_MAX) == 7);
+}
+
+static void tst_conflicts() {
+    smt_params fparams;
+    profile_result r;
+    solve(s_conflicts, fparams, r);
+    std::cout << "conflicts: result " << r.m_result << " matches " << r.m_matches << " instances " << r.m_instances
+              << " instance conflicts " << r.m_conflicts << "\n";
+    ENSURE(r.m_result == l_false);
+    ENSURE(r.m_matches >= r.m_instances && r.m_instances > 0);
+    ENSURE(r.m_conflicts > 0);
+    ENSURE(r.m_matching_loops == 0);
+    check_profile(r);
+}
+
+static void tst_matching_loop() {
+    smt_params fparams;
+    fparams.m_mbqi = false;
+    // instances of every generation are eager, the loop is cut by the number of instances
+    fparams.m_qi_eager_threshold = 1e6;
+    fparams.m_qi_max_instances = 2000;
+    profile_result r;
+    solve(s_loop, fparams, r);
+    std::cout << "loop: result " << r.m_result << " instances " << r.m_instances << " matching loops " << r.m_matching_loops << "\n";
+    ENSURE(r.m_result != l_false);
+    ENSURE(r.m_instances >= 1024);
+    ENSURE(r.m_matching_loops == 1);
+    check_profile(r);
+    json_value const& q = r.m_profile.get("quantifiers")->m_array[0];
+    ENSURE(q.get("qid")->m_string == "loop");
+    ENSURE(q.get("matching_loop")->m_bool);
+    ENSURE(q.get("max_generation")->m_number >= 32);
+}
+
+void tst_qi_profile() {
+    tst_generation_buckets();
+    tst_conflicts();
+    tst_matching_loop();
+}
@@ -0,0 +1,173 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    qi_throttle.cpp
+
+Abstract:
+
+    Tests for the throttling of quantifiers whose instances are not used in
+    conflicts (smt.qi.throttle).
+
+    An unsatisfiable benchmark with case splits that need instances is
+    combined with a quantifier that produces many instances and is never
+    used in a conflict. Its seeds are in case splits, so it grows after the
+    first conflicts. The verdict must not depend on throttling, and the
+    instances of the second quantifier are throttled. The decay of the
+    conflict scores is also checked for gaps where pow(decay, gap)
+    underflows, and decays outside (0, 1] must be rejected.
+
+--*/
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "params/qi_params.h"
+#include "params/smt_params.h"
+#include "smt/smt_context.h"
+#include "smt/qi_queue.h"
+#include "smt/smt_kernel.h"
+#include "smt/smt_quantifier.h"
+#include "util/statistics.h"
+
+static char const* s_benchmark = R"(
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun k (U) Int)
+(declare-fun p (U) Bool)
+(declare-fun w (U) U)
+(declare-fun l (U) U)
+(declare-fun r (U) U)
+(declare-const a0 U)
+(declare-const a1 U)
+(declare-const a2 U)
+(declare-const a3 U)
+(declare-const a4 U)
+(declare-const a5 U)
+(assert (forall ((x U)) (! (= (k (f x)) (+ (k x) 1)) :pattern ((f x)) :qid kf)))
+(assert (forall ((x U)) (! (= (k (g x)) (* 2 (k x))) :pattern ((g x)) :qid kg)))
+(assert (forall ((x U)) (! (=> (p x) (p (f x))) :pattern ((f x)) :qid pf)))
+(assert (forall ((x U)) (! (=> (p x) (p (g x))) :pattern ((g x)) :qid pg)))
+(assert (forall ((x U)) (! (= (w (l x)) (w (r x))) :pattern ((w x)) :qid tree)))
+(assert (p a0))
+(assert (= (k a0) 1))
+(assert (or (= a1 (f a0)) (= a1 (g a0))))
+(assert (or (= a2 (f a1)) (= a2 (g a1))))
+(assert (or (= a3 (f a2)) (and (= a3 (g a2)) (= (w a3) a0))))
+(assert (or (= a4 (f a3)) (and (= a4 (g a3)) (= (w a4) a0))))
+(assert (or (= a5 (f a4)) (and (= a5 (g a4)) (= (w a5) a0))))
+(assert (or (not (p a5)) (< (k a5) 6)))
+)";
+
+static lbool check(smt_params& fparams, unsigned& throttled) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::istringstream in(s_benchmark);
+    VERIFY(parse_smt2_commands(ctx, in));
+    smt::kernel solver(m, fparams);
+    for (expr* e : ctx.assertions())
+        solver.assert_expr(e);
+    lbool r = solver.check();
+    statistics st;
+    solver.collect_statistics(st);
+    throttled = 0;
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), "quant throttled instances") == 0)
+            throttled = st.get_uint_value(i);
+    return r;
+}
+
+static void tst_verdict() {
+    smt_params fparams;
+    unsigned throttled = 0;
+    lbool expected = check(fparams, throttled);
+    ENSURE(expected == l_false);
+    fparams.m_qi_throttle = true;
+    for (double decay : { 0.95, 1.0, 1e-300 }) {
+        fparams.m_qi_throttle_decay = decay;
+        lbool r = check(fparams, throttled);
+        std::cout << "decay " << decay << " result " << r << " throttled instances " << throttled << "\n";
+        ENSURE(r == expected);
+        ENSURE(throttled > 0);
+    }
+}
+
+// conflict gaps where pow(decay, gap) is 0 reset the scores and the increment.
+static void tst_decay_underflow() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context cmd(false, &m);
+    cmd.set_ignore_check(true);
+    std::istringstream in(s_benchmark);
+    VERIFY(parse_smt2_commands(cmd, in));
+    ptr_vector<quantifier> qs;
+    for (expr* e : cmd.assertions())
+        if (is_quantifier(e))
+            qs.push_back(to_quantifier(e));
+    ENSURE(qs.size() >= 2);
+    smt_params fparams;
+    fparams.m_mbqi = false;
+    fparams.m_qi_throttle = true;
+    smt::context ctx(m, fparams);
+    smt::quantifier_manager qm(ctx, fparams, params_ref());
+    for (quantifier* q : qs)
+        qm.add(q, 0);
+    smt::qi_queue queue(qm, ctx, fparams);
+    queue.setup();
+    q::quantifier_stat* s0 = qm.get_stat(qs[0]);
+    q::quantifier_stat* s1 = qm.get_stat(qs[1]);
+
+    queue.bump_conflict_score(s0, 1);
+    ENSURE(s0->get_conflict_score() > 1 && s1->get_conflict_score() == 0);
+    // 0.95^(10^6) underflows to 0, the score of s0 decays to 0
+    queue.bump_conflict_score(s1, 1000001);
+    ENSURE(s0->get_conflict_score() == 0);
+    ENSURE(s1->get_conflict_score() == 1);
+    queue.bump_conflict_score(s0, 1000002);
+    ENSURE(std::isfinite(s0->get_conflict_score()));
+    ENSURE(s0->get_conflict_score() > s1->get_conflict_score());
+    // a large gap after a long run of bumps
+    for (unsigned c = 1000003; c < 1020000; ++c)
+        queue.bump_conflict_score(c % 2 == 0 ? s0 : s1, c);
+    ENSURE(std::isfinite(s0->get_conflict_score()) && std::isfinite(s1->get_conflict_score()));
+    queue.bump_conflict_score(s1, UINT_MAX - 1);
+    ENSURE(s0->get_conflict_score() == 0);
+    ENSURE(s1->get_conflict_score() == 1);
+}
+
+static void tst_decay_range() {
+    for (double decay : { 0.0, -0.5, 1.5, 1e300 }) {
+        qi_params qp;
+        params_ref p;
+        p.set_double("qi.throttle_decay", decay);
+        bool rejected = false;
+        try {
+            qp.updt_params(p);
+        }
+        catch (default_exception&) {
+            rejected = true;
+        }
+        ENSURE(rejected);
+    }
+    for (double decay : { 1e-300, 0.5, 1.0 }) {
+        qi_params qp;
+        params_ref p;
+        p.set_double("qi.throttle_decay", decay);
+        qp.updt_params(p);
+        ENSURE(qp.m_qi_throttle_decay == decay);
+    }
+}
+
+void tst_qi_throttle() {
+    tst_decay_range();
+    tst_decay_underflow();
+    tst_verdict();
+}
@@ -22,6 +22,10 @@ Revision History:
 #include "util/trace.h"
 #include "util/ext_gcd.h"
 #include "util/timeit.h"
+#include "util/stopwatch.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 static void tst1() {
     rational r1(1);
@@ -489,6 +493,93 @@ static void tst13() {
 }
 
 
+// Arithmetic on rationals with small numerators and denominators takes a
+// 64-bit fast path. Check it against the same operations on scaled operands,
+// whose intermediate results do not fit in machine integers.
+static void tst_small_kernels() {
+    rational big = rational::power_of_two(70);
+    int vals[] = { 0, 1, -1, 2, -3, 7, 1000003, -1000003, INT_MAX, INT_MIN + 1, INT_MIN, INT_MAX - 1 };
+    unsigned n = sizeof(vals) / sizeof(vals[0]);
+    for (unsigned i = 0; i < n; ++i)
+        for (unsigned j = 0; j < n; ++j)
+            for (unsigned k = 1; k < n; ++k) {
+                int d1 = vals[k] < 0 ? -(vals[k] + 1) : vals[k];
+                int d2 = vals[(k + i) % n] < 0 ? -(vals[(k + i) % n] + 1) : vals[(k + i) % n];
+                if (d1 == 0 || d2 == 0)
+                    continue;
+                rational a(vals[i], d1), b(vals[j], d2);
+                rational A = a * big, B = b * big;
+                VERIFY(a + b == (A + B) / big);
+                VERIFY(a - b == (A - B) / big);
+                VERIFY(a * b == (A * B) / (big * big));
+                if (!b.is_zero())
+                    VERIFY(a / b == A / B);
+            }
+}
+
+// Timings of the arithmetic kernels used by the arithmetic solvers.
+static void tst_small_kernels_bench() {
+    unsigned n = 200000;
+    vector<rational> as, bs;
+    unsigned seed = 17;
+    auto next = [&]() { seed = seed * 1103515245 + 12345; return (seed >> 8) % 2001; };
+    for (unsigned i = 0; i < 1024; ++i) {
+        as.push_back(rational(static_cast<int>(next()) - 1000, static_cast<int>(next()) + 1));
+        bs.push_back(rational(static_cast<int>(next()) - 1000, static_cast<int>(next()) + 1));
+    }
+    rational r;
+    auto run = [&](char const* name, auto op) {
+        stopwatch sw;
+        sw.start();
+        for (unsigned i = 0; i < n; ++i)
+            op(as[i % 1024], bs[(i * 7) % 1024]);
+        sw.stop();
+        std::cout << "rational " << name << ": " << n << " ops in " << sw.get_seconds() << "s\n";
+    };
+    run("add", [&](rational const& a, rational const& b) { r = a + b; });
+    run("sub", [&](rational const& a, rational const& b) { r = a - b; });
+    run("mul", [&](rational const& a, rational const& b) { r = a * b; });
+    run("div", [&](rational const& a, rational const& b) { if (!b.is_zero()) r = a / b; });
+    run("addmul", [&](rational const& a, rational const& b) { r.addmul(a, b); if (!r.is_small()) r.reset(); });
+}
+
+// Sum of a harmonic-like series whose denominators exceed machine integers.
+// Each step allocates and frees large number temporaries.
+static rational rational_workload(unsigned n) {
+    rational r(0);
+    rational d(1);
+    rational big = rational::power_of_two(80);
+    for (unsigned i = 1; i <= n; ++i) {
+        d = big + rational(i);
+        r += rational(i) / d;
+        if (i % 64 == 0)
+            r = floor(r * rational(1000003)) / rational(1000003);
+    }
+    return r;
+}
+
+// Run the same workload on independent threads and report how wall clock time scales.
+static void tst_rational_threads() {
+#ifndef SINGLE_THREAD
+    unsigned n = 2000;
+    rational expected = rational_workload(n);
+    for (unsigned num_threads : { 1u, 2u, 4u }) {
+        vector<rational> results(num_threads);
+        stopwatch sw;
+        sw.start();
+        vector<std::thread> threads;
+        for (unsigned i = 0; i < num_threads; ++i)
+            threads.push_back(std::thread([&, i]() { results[i] = rational_workload(n); }));
+        for (auto& t : threads)
+            t.join();
+        sw.stop();
+        for (auto const& r : results)
+            VERIFY(r == expected);
+        std::cout << "rational threads: " << num_threads << " time: " << sw.get_seconds() << "s\n";
+    }
+#endif
+}
+
 void tst_rational() {
     TRACE(rational, tout << "starting rational test...\n";);
     std::cout << "sizeof(rational): " << sizeof(rational) << "\n";
@@ -515,4 +606,7 @@ void tst_rational() {
     tst10(false);
     tst12();
     tst13();
+    tst_small_kernels();
+    tst_small_kernels_bench();
+    tst_rational_threads();
 }
@@ -0,0 +1,142 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_cache.cpp
+
+Abstract:
+
+    Tests for the cache of learned clauses, phases and activities (sat.cache).
+
+--*/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "sat/sat_solver.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static char const* s_cache_file = "sat_cache_test.tmp";
+
+static unsigned cache_clauses(sat::solver& s) {
+    statistics st;
+    s.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), "sat cache clauses") == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static params_ref cache_params() {
+    params_ref p;
+    p.set_sym("cache", symbol(s_cache_file));
+    return p;
+}
+
+static void add_random_3sat(sat::solver& s, unsigned num_vars, unsigned num_clauses, unsigned seed) {
+    random_gen r(seed);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal lits[3];
+        for (auto& l : lits)
+            l = sat::literal(r(num_vars), r(2) == 0);
+        s.mk_clause(3, lits);
+    }
+}
+
+// learned clauses saved by one run are reloaded by a run on the same clauses.
+static void tst_reload() {
+    reslimit limit;
+    params_ref p = cache_params();
+    lbool r1, r2;
+    {
+        sat::solver s(p, limit);
+        add_random_3sat(s, 60, 300, 1);
+        r1 = s.check();
+        ENSURE(cache_clauses(s) == 0);
+    }
+    {
+        sat::solver s(p, limit);
+        add_random_3sat(s, 60, 300, 1);
+        r2 = s.check();
+        std::cout << "reload: " << r2 << " cache clauses " << cache_clauses(s) << "\n";
+        ENSURE(cache_clauses(s) > 0);
+    }
+    ENSURE(r1 == r2);
+    {
+        // a different clause set does not match the key of the saved cache.
+        sat::solver s(p, limit);
+        add_random_3sat(s, 60, 300, 2);
+        s.check();
+        ENSURE(cache_clauses(s) == 0);
+    }
+    std::remove(s_cache_file);
+}
+
+static void write_unsigned(std::ostream& out, unsigned v) {
+    out.write(reinterpret_cast<char const*>(&v), sizeof(v));
+}
+
+// clauses in the cache that are not RUP consequences of the current clauses are ignored.
+static void tst_rup_rejected() {
+    reslimit limit;
+    params_ref p = cache_params();
+    auto mk_formula = [](sat::solver& s) {
+        s.mk_var(); s.mk_var(); s.mk_var();
+        s.mk_clause(sat::literal(0, false), sat::literal(1, false));
+        s.mk_clause(sat::literal(0, true), sat::literal(2, false));
+    };
+    {
+        sat::solver s(p, limit);
+        mk_formula(s);
+        ENSURE(s.check() == l_true);
+    }
+    // keep the header, phases and activities and replace the learned clauses:
+    // the units ~x0 and ~x1 are not RUP, but together contradict x0 | x1.
+    // x0 | x1 | x2 is RUP.
+    std::string data;
+    {
+        std::ifstream in(s_cache_file, std::ios::binary);
+        ENSURE(in.good());
+        std::stringstream strm;
+        strm << in.rdbuf();
+        data = strm.str();
+    }
+    unsigned nv = 0;
+    size_t nv_offset = 2 * sizeof(unsigned) + sizeof(uint64_t);
+    ENSURE(data.size() >= nv_offset + sizeof(unsigned));
+    memcpy(&nv, data.data() + nv_offset, sizeof(nv));
+    ENSURE(nv >= 3);
+    size_t clauses_offset = nv_offset + sizeof(unsigned) + nv * (sizeof(unsigned) + 1);
+    ENSURE(data.size() >= clauses_offset);
+    {
+        std::ofstream out(s_cache_file, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), clauses_offset);
+        write_unsigned(out, 3);
+        write_unsigned(out, 1);
+        write_unsigned(out, sat::literal(0, true).index());
+        write_unsigned(out, 1);
+        write_unsigned(out, sat::literal(1, true).index());
+        write_unsigned(out, 3);
+        write_unsigned(out, sat::literal(0, false).index());
+        write_unsigned(out, sat::literal(1, false).index());
+        write_unsigned(out, sat::literal(2, false).index());
+    }
+    {
+        sat::solver s(p, limit);
+        mk_formula(s);
+        ENSURE(s.check() == l_true);
+        ENSURE(cache_clauses(s) == 1);
+    }
+    std::remove(s_cache_file);
+}
+
+void tst_sat_cache() {
+    tst_reload();
+    tst_rup_rejected();
+}
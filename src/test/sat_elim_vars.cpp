@@ -0,0 +1,105 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    sat_elim_vars.cpp
+
+Abstract:
+
+    Tests for bounded variable elimination with sat.elim_vars.threads > 1.
+
+--*/
+
+#include <iostream>
+#include "sat/sat_solver.h"
+#include "util/util.h"
+
+typedef vector<sat::literal_vector> clauses_t;
+
+static void mk_random_clauses(unsigned num_vars, unsigned num_clauses, unsigned seed, clauses_t& clauses) {
+    random_gen r(seed);
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal_vector c;
+        unsigned sz = r(4) == 0 ? 2 : 3;
+        for (unsigned j = 0; j < sz; ++j)
+            c.push_back(sat::literal(r(num_vars), r(2) == 0));
+        clauses.push_back(c);
+    }
+}
+
+struct elim_result {
+    unsigned    m_num_clauses = 0;
+    bool_vector m_eliminated;
+    lbool       m_verdict = l_undef;
+};
+
+static elim_result simplify(unsigned num_vars, clauses_t const& clauses, unsigned threads) {
+    reslimit limit;
+    params_ref p;
+    p.set_uint("elim_vars.threads", threads);
+    sat::solver s(p, limit);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (auto const& c : clauses)
+        s.mk_clause(c.size(), const_cast<sat::literal*>(c.data()));
+    elim_result r;
+    s.simplify(false);
+    r.m_num_clauses = s.num_clauses();
+    for (unsigned v = 0; v < num_vars; ++v)
+        r.m_eliminated.push_back(s.was_eliminated(v));
+    r.m_verdict = s.check();
+    if (r.m_verdict == l_true) {
+        // the model extended to the eliminated variables satisfies the input
+        sat::model const& m = s.get_model();
+        for (auto const& c : clauses)
+            ENSURE(any_of(c, [&](sat::literal l) { return m[l.var()] == (l.sign() ? l_false : l_true); }));
+    }
+    return r;
+}
+
+static void tst_elim_vars(unsigned num_vars, unsigned num_clauses, unsigned seed) {
+    clauses_t clauses;
+    mk_random_clauses(num_vars, num_clauses, seed, clauses);
+    elim_result seq = simplify(num_vars, clauses, 1);
+    elim_result par = simplify(num_vars, clauses, 2);
+    unsigned num_elim = 0;
+    for (bool b : par.m_eliminated)
+        num_elim += b;
+    std::cout << "seed " << seed << " verdict " << par.m_verdict << " eliminated " << num_elim << "\n";
+    // batches defer variables that share clauses, so the elimination order,
+    // but not the verdict, may differ from the sequential path.
+    ENSURE(seq.m_verdict == par.m_verdict);
+    for (unsigned threads : { 3, 8 }) {
+        elim_result r = simplify(num_vars, clauses, threads);
+        ENSURE(r.m_verdict == par.m_verdict);
+        ENSURE(r.m_num_clauses == par.m_num_clauses);
+        ENSURE(r.m_eliminated == par.m_eliminated);
+    }
+}
+
+// variables in disjoint clauses are batched in elimination order,
+// so the result is the same as on the sequential path.
+static void tst_elim_vars_disjoint() {
+    unsigned num_vars = 0;
+    clauses_t clauses;
+    random_gen r(0);
+    for (unsigned i = 0; i < 50; ++i, num_vars += 3) {
+        sat::literal x(num_vars, false), y(num_vars + 1, false), z(num_vars + 2, false);
+        sat::literal c1[2] = { x, y }, c2[2] = { ~x, r(2) == 0 ? z : ~z };
+        clauses.push_back(sat::literal_vector(2, c1));
+        clauses.push_back(sat::literal_vector(2, c2));
+    }
+    elim_result seq = simplify(num_vars, clauses, 1);
+    elim_result par = simplify(num_vars, clauses, 4);
+    ENSURE(seq.m_verdict == l_true && par.m_verdict == l_true);
+    ENSURE(seq.m_num_clauses == par.m_num_clauses);
+    ENSURE(seq.m_eliminated == par.m_eliminated);
+    ENSURE(any_of(par.m_eliminated, [](bool b) { return b; }));
+}
+
+void tst_sat_elim_vars() {
+    tst_elim_vars_disjoint();
+    for (unsigned seed = 0; seed < 4; ++seed)
+        tst_elim_vars(200, seed % 2 == 0 ? 500 : 700, seed);
+}
@@ -0,0 +1,134 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_push_pop.cpp
+
+Abstract:
+
+    Regression test for smt::context::pop after a satisfiable check.
+
+    The context is then still at a search level above the base level, so
+    pop backtracks search levels as well as user scopes. Lemmas learned in
+    the popped user scopes may be in the reinit stack of the search levels,
+    and units may be delayed (smt.delay_units). Every check is compared with
+    a fresh solver for the asserted constraints of the open scopes.
+
+--*/
+
+#include <iostream>
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "model/model.h"
+#include "params/smt_params.h"
+#include "smt/smt_context.h"
+#include "smt/smt_kernel.h"
+#include "util/util.h"
+
+namespace {
+
+    class push_pop_test {
+        ast_manager&          m;
+        arith_util            a;
+        random_gen            m_rand;
+        app_ref_vector        m_vars;
+        func_decl_ref         m_f;
+        expr_ref_vector       m_base;
+        vector<expr_ref_vector> m_scopes;
+
+        expr_ref mk_branch() {
+            expr* x = m_vars.get(m_rand(m_vars.size()));
+            expr* y = m_vars.get(m_rand(m_vars.size()));
+            expr_ref lhs(a.mk_add(a.mk_mul(a.mk_int(m_rand(5) + 1), x), a.mk_mul(a.mk_int(static_cast<int>(m_rand(7)) - 3), y)), m);
+            expr_ref rhs(a.mk_int(static_cast<int>(m_rand(13)) - 6), m);
+            expr_ref r(m);
+            switch (m_rand(4)) {
+            case 0: r = a.mk_le(lhs, rhs); break;
+            case 1: r = a.mk_ge(lhs, rhs); break;
+            case 2: r = m.mk_eq(m.mk_app(m_f.get(), lhs.get()), m.mk_app(m_f.get(), rhs.get())); break;
+            default:
+                r = m.mk_or(m.mk_eq(m.mk_app(m_f.get(), x), y), a.mk_gt(m.mk_app(m_f.get(), y), a.mk_add(x, a.mk_int(3))));
+                break;
+            }
+            if (m_rand(2) == 0)
+                r = m.mk_not(r);
+            return r;
+        }
+
+        lbool check_fresh() {
+            smt_params fparams;
+            smt::kernel s(m, fparams);
+            for (expr* e : m_base)
+                s.assert_expr(e);
+            for (auto const& sc : m_scopes)
+                for (expr* e : sc)
+                    s.assert_expr(e);
+            return s.check();
+        }
+
+    public:
+        push_pop_test(ast_manager& m, unsigned seed):
+            m(m), a(m), m_rand(seed), m_vars(m), m_f(m), m_base(m) {
+            sort* int_sort = a.mk_int();
+            m_f = m.mk_func_decl(symbol("f"), int_sort, int_sort);
+            for (unsigned i = 0; i < 5; ++i) {
+                app* x = m.mk_const(symbol(i), int_sort);
+                m_vars.push_back(x);
+                m_base.push_back(a.mk_le(a.mk_int(-4), x));
+                m_base.push_back(a.mk_le(x, a.mk_int(4)));
+            }
+        }
+
+        // return the number of pops that backtracked search levels
+        unsigned run(unsigned num_steps) {
+            smt_params fparams;
+            fparams.m_delay_units = true;
+            smt::context ctx(m, fparams);
+            for (expr* e : m_base)
+                ctx.assert_expr(e);
+            unsigned num_search_pops = 0;
+            for (unsigned i = 0; i < num_steps; ++i) {
+                if (!m_scopes.empty() && m_rand(100) < 45) {
+                    unsigned n = 1 + m_rand(m_scopes.size());
+                    if (ctx.get_scope_level() > ctx.get_base_level())
+                        ++num_search_pops;
+                    ctx.pop(n);
+                    m_scopes.shrink(m_scopes.size() - n);
+                }
+                else {
+                    ctx.push();
+                    m_scopes.push_back(expr_ref_vector(m));
+                    for (unsigned j = 1 + m_rand(2); j-- > 0; ) {
+                        expr_ref e = mk_branch();
+                        ctx.assert_expr(e);
+                        m_scopes.back().push_back(e);
+                    }
+                }
+                lbool r = ctx.check();
+                ENSURE(r == check_fresh());
+                if (r == l_true) {
+                    model_ref mdl;
+                    ctx.get_model(mdl);
+                    for (expr* e : m_base)
+                        ENSURE(mdl->is_true(e));
+                    for (auto const& sc : m_scopes)
+                        for (expr* e : sc)
+                            ENSURE(mdl->is_true(e));
+                }
+            }
+            return num_search_pops;
+        }
+    };
+}
+
+void tst_smt_push_pop() {
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        ast_manager m;
+        reg_decl_plugins(m);
+        push_pop_test t(m, seed);
+        unsigned n = t.run(300);
+        std::cout << "seed " << seed << " pops from search levels " << n << "\n";
+        ENSURE(n > 0);
+    }
+}
@@ -0,0 +1,158 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_push_pop_bench.cpp
+
+Abstract:
+
+    Throughput of push/assert/check/pop on smt::kernel.
+
+    Usage: test-z3 smt_push_pop_bench [-n paths] [-d depth] [-c constants] [-s seed] [smt.foo=val]
+
+    The workload mimics a symbolic executor: the paths of a random tree
+    of branch conditions are explored depth first. Each branch pushes a
+    scope, asserts a linear constraint over a few integer constants that
+    also occurs under an uninterpreted function, and checks. Unsatisfiable
+    branches are cut off. After a path is explored, a random number of
+    scopes is popped.
+
+    One line is printed:
+    (smt-push-pop-bench :pushes 1000 :checks 1000 :sat 800 :unsat 200 :time 1.2 :push-time 0.1 :check-time 0.9 :pop-time 0.2)
+    Global parameters given on the command line are passed to the solver.
+
+--*/
+
+#include <iostream>
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/stopwatch.h"
+#include "util/util.h"
+
+namespace {
+
+    class push_pop_bench {
+        ast_manager&    m;
+        arith_util      a;
+        smt_params      m_fparams;
+        smt::kernel     m_solver;
+        random_gen      m_rand;
+        app_ref_vector  m_vars;
+        func_decl_ref   m_f;
+        stopwatch       m_push_watch, m_check_watch, m_pop_watch;
+        unsigned        m_pushes = 0;
+        unsigned        m_checks = 0;
+        unsigned        m_sat = 0;
+        unsigned        m_unsat = 0;
+
+        expr_ref mk_branch() {
+            expr* x = m_vars.get(m_rand(m_vars.size()));
+            expr* y = m_vars.get(m_rand(m_vars.size()));
+            expr_ref lhs(a.mk_add(a.mk_mul(a.mk_int(m_rand(7) + 1), x), a.mk_mul(a.mk_int(static_cast<int>(m_rand(7)) - 3), y)), m);
+            expr_ref rhs(a.mk_int(static_cast<int>(m_rand(41)) - 20), m);
+            expr_ref r(m);
+            switch (m_rand(3)) {
+            case 0: r = a.mk_le(lhs, rhs); break;
+            case 1: r = a.mk_ge(lhs, rhs); break;
+            default: r = m.mk_eq(m.mk_app(m_f.get(), lhs.get()), m.mk_app(m_f.get(), rhs.get())); break;
+            }
+            if (m_rand(2) == 0)
+                r = m.mk_not(r);
+            return r;
+        }
+
+        void push() {
+            m_push_watch.start();
+            m_solver.push();
+            m_push_watch.stop();
+            ++m_pushes;
+        }
+
+        void pop(unsigned n) {
+            m_pop_watch.start();
+            m_solver.pop(n);
+            m_pop_watch.stop();
+        }
+
+        lbool check() {
+            m_check_watch.start();
+            lbool r = m_solver.check();
+            m_check_watch.stop();
+            ++m_checks;
+            if (r == l_true)
+                ++m_sat;
+            else if (r == l_false)
+                ++m_unsat;
+            return r;
+        }
+
+    public:
+        push_pop_bench(ast_manager& m, unsigned num_vars, unsigned seed):
+            m(m), a(m), m_solver(m, m_fparams), m_rand(seed), m_vars(m), m_f(m) {
+            sort* int_sort = a.mk_int();
+            m_f = m.mk_func_decl(symbol("f"), int_sort, int_sort);
+            for (unsigned i = 0; i < num_vars; ++i) {
+                app* x = m.mk_const(symbol(i), int_sort);
+                m_vars.push_back(x);
+                m_solver.assert_expr(a.mk_le(a.mk_int(-100), x));
+                m_solver.assert_expr(a.mk_le(x, a.mk_int(100)));
+            }
+        }
+
+        void run(unsigned num_paths, unsigned max_depth) {
+            unsigned depth = 0;
+            for (unsigned p = 0; p < num_paths && m.inc(); ++p) {
+                while (depth < max_depth) {
+                    push();
+                    ++depth;
+                    m_solver.assert_expr(mk_branch());
+                    if (check() != l_true)
+                        break;
+                }
+                unsigned n = 1 + m_rand(depth);
+                pop(n);
+                depth -= n;
+            }
+            if (depth > 0)
+                pop(depth);
+        }
+
+        void display(std::ostream& out, double time) {
+            out << "(smt-push-pop-bench :pushes " << m_pushes
+                << " :checks " << m_checks
+                << " :sat " << m_sat
+                << " :unsat " << m_unsat
+                << " :time " << time
+                << " :push-time " << m_push_watch.get_seconds()
+                << " :check-time " << m_check_watch.get_seconds()
+                << " :pop-time " << m_pop_watch.get_seconds()
+                << ")" << std::endl;
+        }
+    };
+}
+
+void tst_smt_push_pop_bench(char** argv, int argc, int& i) {
+    unsigned num_paths = 1000, max_depth = 20, num_vars = 10, seed = 0;
+    while (i + 2 < argc && argv[i + 1][0] == '-') {
+        unsigned v = atoi(argv[i + 2]);
+        switch (argv[i + 1][1]) {
+        case 'n': num_paths = v; break;
+        case 'd': max_depth = std::max(v, 1u); break;
+        case 'c': num_vars = std::max(v, 1u); break;
+        case 's': seed = v; break;
+        default: break;
+        }
+        i += 2;
+    }
+    ast_manager m;
+    reg_decl_plugins(m);
+    push_pop_bench b(m, num_vars, seed);
+    stopwatch sw;
+    sw.start();
+    b.run(num_paths, max_depth);
+    sw.stop();
+    b.display(std::cout, sw.get_seconds());
+}
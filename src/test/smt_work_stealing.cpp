@@ -0,0 +1,113 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    smt_work_stealing.cpp
+
+Abstract:
+
+    Tests for parallel SMT with a shared cube tree (smt.threads.work_stealing).
+
+    Small satisfiable and unsatisfiable propositional problems are solved
+    with several threads, and the verdicts are compared with the sequential
+    solver.
+
+--*/
+
+#include <cstring>
+#include <iostream>
+#include "ast/reg_decl_plugins.h"
+#include "params/smt_params.h"
+#include "smt/smt_kernel.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+// n + 1 pigeons in n holes
+static void mk_pigeonhole(ast_manager& m, unsigned n, expr_ref_vector& fmls) {
+    auto p = [&](unsigned i, unsigned j) {
+        return expr_ref(m.mk_const(symbol(("p_" + std::to_string(i) + "_" + std::to_string(j)).c_str()), m.mk_bool_sort()), m);
+    };
+    for (unsigned i = 0; i <= n; ++i) {
+        expr_ref_vector holes(m);
+        for (unsigned j = 0; j < n; ++j)
+            holes.push_back(p(i, j));
+        fmls.push_back(m.mk_or(holes));
+    }
+    for (unsigned j = 0; j < n; ++j)
+        for (unsigned i = 0; i <= n; ++i)
+            for (unsigned k = i + 1; k <= n; ++k)
+                fmls.push_back(m.mk_or(m.mk_not(p(i, j)), m.mk_not(p(k, j))));
+}
+
+static void mk_random_3sat(ast_manager& m, unsigned num_vars, unsigned num_clauses, unsigned seed, expr_ref_vector& fmls) {
+    random_gen r(seed);
+    expr_ref_vector vars(m);
+    for (unsigned i = 0; i < num_vars; ++i)
+        vars.push_back(m.mk_const(symbol(i), m.mk_bool_sort()));
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        expr_ref_vector lits(m);
+        for (unsigned j = 0; j < 3; ++j) {
+            expr* v = vars.get(r(num_vars));
+            lits.push_back(r(2) == 0 ? v : m.mk_not(v));
+        }
+        fmls.push_back(m.mk_or(lits));
+    }
+}
+
+static lbool check(ast_manager& m, expr_ref_vector const& fmls, unsigned threads, unsigned& num_cubes, unsigned& num_splits) {
+    smt_params fparams;
+    fparams.m_threads = threads;
+    fparams.m_threads_work_stealing = true;
+    // a small budget per cube makes the workers return to the tree often,
+    // exchange units and split their cubes.
+    fparams.m_threads_max_conflicts = 20;
+    smt::kernel s(m, fparams);
+    for (expr* e : fmls)
+        s.assert_expr(e);
+    lbool r = s.check();
+    if (r == l_true) {
+        model_ref mdl;
+        s.get_model(mdl);
+        for (expr* e : fmls)
+            ENSURE(mdl->is_true(e));
+    }
+    statistics st;
+    s.collect_statistics(st);
+    num_cubes = num_splits = 0;
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (strcmp(st.get_key(i), "smt parallel cubes") == 0)
+            num_cubes = st.get_uint_value(i);
+        if (strcmp(st.get_key(i), "smt parallel splits") == 0)
+            num_splits = st.get_uint_value(i);
+    }
+    return r;
+}
+
+static void tst_instance(char const* name, ast_manager& m, expr_ref_vector const& fmls) {
+    unsigned num_cubes = 0, num_splits = 0;
+    lbool expected = check(m, fmls, 1, num_cubes, num_splits);
+    for (unsigned threads : { 2, 3 }) {
+        lbool r = check(m, fmls, threads, num_cubes, num_splits);
+        std::cout << name << " threads " << threads << " " << r << " cubes " << num_cubes << " splits " << num_splits << "\n";
+        ENSURE(r == expected);
+        // the sequential prefix does not solve the problem, so cubes are claimed from the tree.
+        // The number of workers is bounded by the hardware concurrency, so splits are not required.
+        ENSURE(num_cubes > 0);
+    }
+}
+
+void tst_smt_work_stealing() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    {
+        expr_ref_vector fmls(m);
+        mk_pigeonhole(m, 6, fmls);
+        tst_instance("pigeonhole", m, fmls);
+    }
+    {
+        expr_ref_vector fmls(m);
+        mk_random_3sat(m, 120, 480, 1, fmls);
+        tst_instance("3sat", m, fmls);
+    }
+}
@@ -0,0 +1,172 @@
+/*++
+Copyright (c) 2025 Microsoft Corporation
+
+Module Name:
+
+    term_gcd_bounds.cpp
+
+Abstract:
+
+    Tests for the tightening of bounds on integer terms by the gcd of their
+    coefficients (lp.term_gcd_bounds).
+
+    Bounds on terms are added to a lar_solver directly and the stored
+    constraints are inspected. For random bounds on terms with a common
+    factor, the stored bounds must have the same integer solutions as the
+    added bounds.
+
+--*/
+
+#include <iostream>
+#include "math/lp/lar_solver.h"
+#include "util/util.h"
+
+namespace {
+
+    typedef vector<std::pair<rational, lp::lpvar>> coeffs_t;
+
+    class term_gcd_test {
+        lp::lar_solver m_lra;
+        lp::lpvar      m_x, m_y, m_z;
+        unsigned       m_ext = 0;
+
+    public:
+        term_gcd_test(bool enable) {
+            params_ref p;
+            p.set_bool("term_gcd_bounds", enable);
+            m_lra.updt_params(p);
+            m_x = m_lra.add_var(m_ext++, true);
+            m_y = m_lra.add_var(m_ext++, true);
+            m_z = m_lra.add_var(m_ext++, false);
+        }
+
+        // add c1*x + c2*v k rhs and check the stored constraint
+        void check_bound(rational const& c1, lp::lpvar v, rational const& c2, lp::lconstraint_kind k, rational const& rhs,
+                         lp::lconstraint_kind expected_kind, rational const& expected_rhs) {
+            coeffs_t coeffs;
+            coeffs.push_back({ c1, m_x });
+            coeffs.push_back({ c2, v });
+            lp::lpvar t = m_lra.add_term(coeffs, m_ext++);
+            lp::constraint_index ci = m_lra.add_var_bound(t, k, rhs);
+            auto const& c = m_lra.constraints()[ci];
+            ENSURE(c.kind() == expected_kind);
+            ENSURE(c.rhs() == expected_rhs);
+        }
+
+        lp::lpvar x() const { return m_x; }
+        lp::lpvar y() const { return m_y; }
+        lp::lpvar z() const { return m_z; }
+        unsigned num_tightened() { return m_lra.stats().m_term_gcd_bounds; }
+    };
+}
+
+static void tst_tighten() {
+    rational two(2), four(4), five(5);
+    term_gcd_test t(true);
+    // 2x + 4y <= 5 is 2x + 4y <= 4, and 2x + 4y >= 5 is 2x + 4y >= 6
+    t.check_bound(two, t.y(), four, lp::LE, five, lp::LE, rational(4));
+    t.check_bound(two, t.y(), four, lp::GE, five, lp::GE, rational(6));
+    ENSURE(t.num_tightened() == 2);
+    // bounds that are multiples of the gcd are kept
+    t.check_bound(two, t.y(), four, lp::LE, rational(-6), lp::LE, rational(-6));
+    // strict bounds are not tightened
+    t.check_bound(two, t.y(), four, lp::LT, five, lp::LT, five);
+    t.check_bound(two, t.y(), four, lp::GT, five, lp::GT, five);
+    // terms over real columns or with non-integer coefficients are not tightened
+    t.check_bound(two, t.z(), four, lp::LE, five, lp::LE, five);
+    t.check_bound(two, t.y(), rational(3, 2), lp::LE, five, lp::LE, five);
+    // coefficients with gcd 1
+    t.check_bound(two, t.y(), rational(3), lp::LE, five, lp::LE, five);
+    ENSURE(t.num_tightened() == 2);
+
+    term_gcd_test off(false);
+    off.check_bound(two, off.y(), four, lp::LE, five, lp::LE, five);
+    off.check_bound(two, off.y(), four, lp::GE, five, lp::GE, five);
+    ENSURE(off.num_tightened() == 0);
+}
+
+static bool holds(rational const& v, lp::lconstraint_kind k, rational const& rhs) {
+    switch (k) {
+    case lp::LE: return v <= rhs;
+    case lp::LT: return v < rhs;
+    case lp::GE: return v >= rhs;
+    case lp::GT: return v > rhs;
+    default: return v == rhs;
+    }
+}
+
+// Random bounds on terms whose coefficients share a factor are added to a lar_solver over
+// integer columns in [-4, 4]. Every stored bound has the same integer solutions as the bound
+// that was added, and the LP relaxation is only infeasible if there is no integer solution.
+// The arithmetic rewriter divides integer atoms by the gcd of their coefficients, so such
+// terms are created in lar_solver directly instead of through the SMT core.
+static void tst_random_bounds(random_gen& r, unsigned& tightened, unsigned& num_infeasible) {
+    unsigned const n = 3;
+    lp::lar_solver lra;
+    params_ref p;
+    p.set_bool("term_gcd_bounds", true);
+    lra.updt_params(p);
+    unsigned ext = 0;
+    for (unsigned i = 0; i < n; ++i) {
+        lp::lpvar x = lra.add_var(ext++, true);
+        lra.add_var_bound(x, lp::GE, rational(-4));
+        lra.add_var_bound(x, lp::LE, rational(4));
+    }
+    vector<coeffs_t> terms;
+    vector<std::pair<lp::lconstraint_kind, rational>> bounds;
+    unsigned_vector cis;
+    static const lp::lconstraint_kind kinds[] = { lp::LE, lp::LT, lp::GE, lp::GT, lp::EQ };
+    for (unsigned i = 0; i < 3; ++i) {
+        int g = r(3) == 0 ? 6 : 2 + r(2);
+        coeffs_t coeffs;
+        for (unsigned j = 0; j < n; ++j) {
+            int c = static_cast<int>(r(5)) - 2;
+            if (c != 0)
+                coeffs.push_back({ rational(g * c), j });
+        }
+        if (coeffs.empty())
+            continue;
+        lp::lpvar t = lra.add_term(coeffs, ext++);
+        lp::lconstraint_kind k = kinds[r(5)];
+        // integer columns do not take fractional equalities
+        rational rhs(static_cast<int>(r(61)) - 30, k == lp::EQ ? 1 : 1 + r(2));
+        terms.push_back(coeffs);
+        bounds.push_back({ k, rhs });
+        cis.push_back(lra.add_var_bound(t, k, rhs));
+    }
+    bool has_solution = false;
+    int const box = 9;
+    for (unsigned idx = 0; idx < box * box * box; ++idx) {
+        int vals[n] = { static_cast<int>(idx % box) - 4, static_cast<int>((idx / box) % box) - 4, static_cast<int>(idx / (box * box)) - 4 };
+        bool all = true;
+        for (unsigned i = 0; i < terms.size(); ++i) {
+            rational v(0);
+            for (auto const& [c, j] : terms[i])
+                v += c * rational(vals[j]);
+            auto const& c = lra.constraints()[cis[i]];
+            bool orig = holds(v, bounds[i].first, bounds[i].second);
+            ENSURE(orig == holds(v, c.kind(), c.rhs()));
+            all &= orig;
+        }
+        has_solution |= all;
+    }
+    if (lra.find_feasible_solution() == lp::lp_status::INFEASIBLE) {
+        ENSURE(!has_solution);
+        ++num_infeasible;
+    }
+    tightened += lra.stats().m_term_gcd_bounds;
+}
+
+static void tst_random() {
+    random_gen r(0);
+    unsigned tightened = 0, num_infeasible = 0;
+    for (unsigned i = 0; i < 300; ++i)
+        tst_random_bounds(r, tightened, num_infeasible);
+    std::cout << "tightened bounds " << tightened << " infeasible " << num_infeasible << "\n";
+    ENSURE(tightened > 0 && num_infeasible > 0);
+}
+
+void tst_term_gcd_bounds() {
+    tst_tighten();
+    tst_random();
+}
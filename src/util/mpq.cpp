@@ -323,6 +323,110 @@ unsigned mpq_manager<SYNCH>::next_power_of_two(mpq const & a) {
     return next_power_of_two(_tmp);
 }
 
+#ifdef __has_builtin
+#define HAS_BUILTIN(X) __has_builtin(X)
+#else
+#define HAS_BUILTIN(X) 0
+#endif
+
+static inline bool add_overflow(int64_t a, int64_t b, int64_t & r) {
+#if HAS_BUILTIN(__builtin_add_overflow)
+    return __builtin_add_overflow(a, b, &r);
+#else
+    if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b))
+        return true;
+    r = a + b;
+    return false;
+#endif
+}
+
+static inline bool sub_overflow(int64_t a, int64_t b, int64_t & r) {
+#if HAS_BUILTIN(__builtin_sub_overflow)
+    return __builtin_sub_overflow(a, b, &r);
+#else
+    if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b))
+        return true;
+    r = a - b;
+    return false;
+#endif
+}
+
+static inline int64_t val64(mpz const & a) {
+    return static_cast<int64_t>(a.value());
+}
+
+static inline uint64_t abs64(int64_t v) {
+    return v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+}
+
+// gcd of absolute values of small numbers, |INT_MIN| does not fit in 31 bits
+static inline int64_t small_gcd(int64_t a, int64_t b) {
+    uint64_t u = abs64(a), v = abs64(b);
+    if (u <= INT_MAX && v <= INT_MAX)
+        return u_gcd(static_cast<unsigned>(u), static_cast<unsigned>(v));
+    return static_cast<int64_t>(u64_gcd(u, v));
+}
+
+template<bool SYNCH>
+void mpq_manager<SYNCH>::set_small(mpq & c, int64_t n, int64_t d) {
+    SASSERT(d > 0);
+    mpz_manager<SYNCH>::set(c.m_num, n);
+    mpz_manager<SYNCH>::set(c.m_den, d);
+}
+
+// Small values fit in 32 bits, so the products below fit in 63 bits.
+// The sum of two products is checked for overflow.
+// The gcd computations follow lin_arith_op and rat_mul, so the results are normalized.
+template<bool SYNCH>
+template<bool SUB>
+bool mpq_manager<SYNCH>::small_lin_arith_op(mpq const & a, mpq const & b, mpq & c) {
+    SASSERT(is_small(a) && is_small(b));
+    int64_t an = val64(a.m_num), ad = val64(a.m_den);
+    int64_t bn = val64(b.m_num), bd = val64(b.m_den);
+    int64_t g = small_gcd(ad, bd);
+    int64_t n;
+    if (g == 1) {
+        if (SUB ? sub_overflow(an * bd, bn * ad, n) : add_overflow(an * bd, bn * ad, n))
+            return false;
+        set_small(c, n, ad * bd);
+        return true;
+    }
+    int64_t ad_g = ad / g;
+    if (SUB ? sub_overflow(an * (bd / g), bn * ad_g, n) : add_overflow(an * (bd / g), bn * ad_g, n))
+        return false;
+    int64_t d = ad_g * bd;
+    int64_t g2 = small_gcd(static_cast<int64_t>(abs64(n) % static_cast<uint64_t>(g)), g);
+    set_small(c, n / g2, d / g2);
+    return true;
+}
+
+template<bool SYNCH>
+void mpq_manager<SYNCH>::small_mul(mpq const & a, mpq const & b, mpq & c) {
+    SASSERT(is_small(a) && is_small(b));
+    int64_t an = val64(a.m_num), ad = val64(a.m_den);
+    int64_t bn = val64(b.m_num), bd = val64(b.m_den);
+    int64_t g1 = small_gcd(an, bd);
+    int64_t g2 = small_gcd(bn, ad);
+    set_small(c, (an / g1) * (bn / g2), (ad / g2) * (bd / g1));
+}
+
+template<bool SYNCH>
+void mpq_manager<SYNCH>::small_div(mpq const & a, mpq const & b, mpq & c) {
+    SASSERT(is_small(a) && is_small(b));
+    SASSERT(!is_zero(b));
+    int64_t an = val64(a.m_num), ad = val64(a.m_den);
+    int64_t bn = val64(b.m_num), bd = val64(b.m_den);
+    int64_t g1 = small_gcd(an, bn);
+    int64_t g2 = small_gcd(ad, bd);
+    int64_t n = (an / g1) * (bd / g2);
+    int64_t d = (ad / g2) * (bn / g1);
+    if (d < 0) {
+        n = -n;
+        d = -d;
+    }
+    set_small(c, n, d);
+}
+
 template<bool SYNCH>
 template<bool SUB>
 void mpq_manager<SYNCH>::lin_arith_op(mpq const& a, mpq const& b, mpq& c, mpz& g, mpz& tmp1, mpz& tmp2, mpz& tmp3) {
@@ -382,7 +486,10 @@ void mpq_manager<SYNCH>::rat_mul(mpz const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c) {
     STRACE(rat_mpq, tout << "[mpq] " << to_string(a) << " * " << to_string(b) << " == ";); 
-    if (SYNCH) {
+    if (is_small(a) && is_small(b)) {
+        small_mul(a, b, c);
+    }
+    else if (SYNCH) {
         mpz g1, g2, tmp1, tmp2;
         rat_mul(a, b, c, g1, g2, tmp1, tmp2);
         del(g1);
@@ -399,6 +506,10 @@ void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_add(mpq const & a, mpq const & b, mpq & c) {
     STRACE(rat_mpq, tout << "[mpq] " << to_string(a) << " + " << to_string(b) << " == ";); 
+    if (is_small(a) && is_small(b) && small_lin_arith_op<false>(a, b, c)) {
+        STRACE(rat_mpq, tout << to_string(c) << "\n";);
+        return;
+    }
     if (SYNCH) {
         mpz_stack tmp1, tmp2, tmp3, g;
         lin_arith_op<false>(a, b, c, g, tmp1, tmp2, tmp3);
@@ -416,6 +527,10 @@ void mpq_manager<SYNCH>::rat_add(mpq const & a, mpq const & b, mpq & c) {
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_sub(mpq const & a, mpq const & b, mpq & c) {
     STRACE(rat_mpq, tout << "[mpq] " << to_string(a) << " - " << to_string(b) << " == ";); 
+    if (is_small(a) && is_small(b) && small_lin_arith_op<true>(a, b, c)) {
+        STRACE(rat_mpq, tout << to_string(c) << "\n";);
+        return;
+    }
     if (SYNCH) {
         mpz tmp1, tmp2, tmp3, g;
         lin_arith_op<true>(a, b, c, g, tmp1, tmp2, tmp3);
@@ -105,6 +105,17 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_mul(mpq const & a, mpq const & b, mpq & c, mpz& g1, mpz& g2, mpz& tmp1, mpz& tmp2);
 
+    // Fast paths for operands whose numerators and denominators are small.
+    // The intermediate results are computed in 64-bit arithmetic.
+    void set_small(mpq & c, int64_t n, int64_t d);
+
+    template<bool SUB>
+    bool small_lin_arith_op(mpq const & a, mpq const & b, mpq & c);
+
+    void small_mul(mpq const & a, mpq const & b, mpq & c);
+
+    void small_div(mpq const & a, mpq const & b, mpq & c);
+
 public:
     typedef mpq numeral;
     typedef mpq rational;
@@ -436,6 +447,11 @@ public:
             set(c, a);
             return;
         }
+        if (is_small(a) && is_small(b)) {
+            small_div(a, b, c);
+            STRACE(mpq, tout << to_string(c) << "\n";);
+            return;
+        }
         if (&b == &c) {
             mpz tmp; // it is not safe to use c.m_num at this point.
             mul(a.m_num, b.m_den, tmp);
@@ -191,6 +191,61 @@ mpz_manager<SYNCH>::~mpz_manager() {
 }
 
 #ifndef _MP_GMP
+#ifndef SINGLE_THREAD
+/**
+   \brief Per-thread cache of cells with the initial capacity.
+
+   The synchronized manager is shared by all threads (e.g., rational uses a
+   single global manager), so it cannot use its small object allocator.
+   Temporaries created by arithmetic operations instead go through this cache,
+   which avoids a malloc/free pair per operation and does not require any
+   synchronization. The cells are ordinary heap blocks, so a cell freed by
+   a thread other than the one that allocated it is simply cached there.
+*/
+namespace {
+    struct mpz_cell_cache {
+        static const unsigned max_cells = 64;
+        void *   m_cells[max_cells];
+        unsigned m_size;
+        bool     m_finalized;
+    };
+
+    // trivially destructible, so it is usable during thread and process exit.
+    static thread_local mpz_cell_cache g_mpz_cell_cache;
+
+    struct mpz_cell_cache_finalizer {
+        bool m_active = false;
+        ~mpz_cell_cache_finalizer() {
+            mpz_cell_cache & c = g_mpz_cell_cache;
+            while (c.m_size > 0)
+                memory::deallocate(c.m_cells[--c.m_size]);
+            c.m_finalized = true;
+        }
+    };
+
+    static thread_local mpz_cell_cache_finalizer g_mpz_cell_cache_finalizer;
+
+    inline void * cached_cell_alloc(size_t sz) {
+        mpz_cell_cache & c = g_mpz_cell_cache;
+        if (c.m_size > 0)
+            return c.m_cells[--c.m_size];
+        return memory::allocate(sz);
+    }
+
+    inline void cached_cell_dealloc(void * p) {
+        mpz_cell_cache & c = g_mpz_cell_cache;
+        if (c.m_size < mpz_cell_cache::max_cells && !c.m_finalized) {
+            if (c.m_size == 0)
+                g_mpz_cell_cache_finalizer.m_active = true; // register the finalizer for this thread
+            c.m_cells[c.m_size++] = p;
+        }
+        else {
+            memory::deallocate(p);
+        }
+    }
+}
+#endif
+
 template<bool SYNCH>
 mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     SASSERT(capacity >= m_init_cell_capacity);
@@ -198,7 +253,10 @@ mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
 #ifdef SINGLE_THREAD
     cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
 #else
-    if (SYNCH) {
+    if (SYNCH && capacity == m_init_cell_capacity) {
+        cell = reinterpret_cast<mpz_cell*>(cached_cell_alloc(cell_size(capacity)));
+    }
+    else if (SYNCH) {
         cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
     }
     else {
@@ -217,7 +275,10 @@ void mpz_manager<SYNCH>::deallocate(bool is_heap, mpz_cell * ptr) {
 #ifdef SINGLE_THREAD
         m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
 #else
-        if (SYNCH) {
+        if (SYNCH && ptr->m_capacity == m_init_cell_capacity) {
+            cached_cell_dealloc(ptr);
+        }
+        else if (SYNCH) {
             memory::deallocate(ptr);
         }
         else {
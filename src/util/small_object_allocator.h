@@ -44,6 +44,9 @@ public:
     void reset();
     void * allocate(size_t size);
     void deallocate(size_t size, void * p);
+    // true if objects of the given size are carved from the chunks of the allocator, and
+    // so released by reset. Other objects are obtained from memory::allocate.
+    static bool is_chunked(size_t size);
     size_t get_allocation_size() const { return m_alloc_size; }
     size_t get_wasted_size() const;
     size_t get_num_free_objs() const;